@@ -148,6 +148,8 @@ typedef struct
   int type;               /* Table type (builtin/external) */
   int optimization;       /* Table optimization type (speed/size) */ 
   _CONST __uint16_t *tbl; /* Table's data */
+  _PTR map;               /* Mapped external file, or NULL */
+  size_t map_len;         /* Mapped external file length */
 } iconv_ccs_desc_t;
 
 /* Array containing all built-in CCS tables */
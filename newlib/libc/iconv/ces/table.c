@@ -36,6 +36,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/stat.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 #include <sys/iconvnls.h>
 #include "../lib/endian.h"
 #include "../lib/local.h"
@@ -53,6 +57,9 @@
  * linked-in tables. If not found, it tries to load it from external file
  * (only if corespondent capability was enabled in Newlib configuration). 
  *
+ * External tables are mapped into memory if the system supports mmap(),
+ * and read otherwise.
+ *
  * 16 bit encodings are assumed to be Big Endian.
  */
 
@@ -80,6 +87,11 @@ _DEFUN(table_close, (rptr, data),
 {
   _CONST iconv_ccs_desc_t *ccsp = (iconv_ccs_desc_t *)data;
 
+#ifdef HAVE_MMAP
+  if (ccsp->map != NULL)
+    munmap (ccsp->map, ccsp->map_len);
+  else
+#endif
   if (ccsp->type == TABLE_EXTERNAL)
     _free_r (rptr, (_VOID_PTR)ccsp->tbl);
 
@@ -112,6 +124,7 @@ _DEFUN(table_init_from_ucs, (rptr, encoding),
         return NULL;
 
       ccsp->type = TABLE_BUILTIN;
+      ccsp->map = NULL;
       ccsp->bits = biccsp->bits;
       ccsp->optimization = biccsp->from_ucs_type;
       ccsp->tbl = biccsp->from_ucs;
@@ -195,6 +208,7 @@ _DEFUN(table_init_to_ucs, (rptr, encoding),
         return NULL;
 
       ccsp->type = TABLE_BUILTIN;
+      ccsp->map = NULL;
       ccsp->bits = biccsp->bits;
       ccsp->optimization = biccsp->to_ucs_type;
       ccsp->tbl = biccsp->to_ucs;
@@ -288,6 +302,51 @@ _iconv_from_ucs_ces_handlers_table =
 };
 #endif /* ICONV_TO_UCS_CES_TABLE */
 
+#if defined (ICONV_TO_UCS_CES_TABLE) \
+ && defined (ICONV_FROM_UCS_CES_TABLE)
+/*
+ * _iconv_table_byte_map - compose two 8-bit tables.
+ *
+ * PARAMETERS:
+ *     _VOID_PTR to_data - "to UCS" table CES converter data.
+ *     _VOID_PTR from_data - "from UCS" table CES converter data.
+ *     __uint16_t *map - 256-entry map to fill.
+ *
+ * DESCRIPTION:
+ *     Sets map[b] to the byte which byte b of 'to_data' encoding becomes
+ *     in 'from_data' encoding, or to ICONV_BYTE_MAP_SLOW if b is invalid
+ *     or has no counterpart, so that whole buffers may be converted with
+ *     one lookup per byte.
+ *
+ * RETURN:
+ *     0 if both tables are 8-bit, -1 otherwise.
+ */
+int
+_DEFUN(_iconv_table_byte_map, (to_data, from_data, map),
+                              _VOID_PTR to_data   _AND
+                              _VOID_PTR from_data _AND
+                              __uint16_t *map)
+{
+  _CONST iconv_ccs_desc_t *to = (iconv_ccs_desc_t *)to_data;
+  _CONST iconv_ccs_desc_t *from = (iconv_ccs_desc_t *)from_data;
+  ucs2_t ucs, code;
+  int i;
+
+  if (to->bits != TABLE_8BIT || from->bits != TABLE_8BIT)
+    return -1;
+
+  for (i = 0; i < 256; i++)
+    {
+      ucs = (ucs2_t)to->tbl[i];
+      code = ucs == INVALC ? (ucs2_t)INVALC
+             : find_code_speed_8bit (ucs, (_CONST unsigned char *)from->tbl);
+      map[i] = code == INVALC ? ICONV_BYTE_MAP_SLOW : code;
+    }
+
+  return 0;
+}
+#endif
+
 /*
  * Supplementary functions.
  */
@@ -555,6 +614,24 @@ _DEFUN(load_file, (rptr, name, direction),
   if (off == EXTTABLE_NO_TABLE)
     goto error4; /* No correspondent table in file */
 
+#ifdef HAVE_MMAP
+  {
+    struct stat st;
+
+    /* Map the file from its start, since 'off' isn't page-aligned */
+    if (_fstat_r (rptr, fd, &st) == 0
+        && st.st_size >= off + tbllen
+        && (ccsp->map = mmap (NULL, (size_t)(off + tbllen), PROT_READ,
+                              MAP_PRIVATE, fd, 0)) != MAP_FAILED)
+      {
+        ccsp->map_len = (size_t)(off + tbllen);
+        ccsp->tbl = (_CONST __uint16_t *)((char *)ccsp->map + off);
+        goto normal_exit;
+      }
+    ccsp->map = NULL;
+  }
+#endif
+
   if ((ccsp->tbl = (ucs2_t *)_malloc_r (rptr, tbllen)) == NULL)
     goto error4;
 
@@ -578,6 +655,11 @@ error2:
     {
       if (ccsp != NULL)
         {
+#ifdef HAVE_MMAP
+          if (ccsp->map != NULL)
+            munmap (ccsp->map, ccsp->map_len);
+          else
+#endif
           if (ccsp->tbl != NULL)
             _free_r (rptr, (_VOID_PTR)ccsp->tbl);
           _free_r (rptr, (_VOID_PTR)ccsp);
@@ -32,6 +32,7 @@
 #include "local.h"
 #include "conv.h"
 #include "ucsconv.h"
+#include "../ces/cesbi.h"
 
 static int fake_data;
 
@@ -110,6 +111,24 @@ _DEFUN(ucs_based_conversion_open, (rptr, to, from),
   else
     uc->from_ucs.data = (_VOID_PTR)&fake_data;
 
+#if defined (ICONV_TO_UCS_CES_TABLE) \
+ && defined (ICONV_FROM_UCS_CES_TABLE)
+  /* Conversions between 8-bit tables go through a single byte map */
+  if (uc->to_ucs.handlers == &_iconv_to_ucs_ces_handlers_table
+      && uc->from_ucs.handlers == &_iconv_from_ucs_ces_handlers_table)
+    {
+      uc->byte_map = (__uint16_t *)
+                     _malloc_r (rptr, 256 * sizeof (__uint16_t));
+      if (uc->byte_map != NULL
+          && _iconv_table_byte_map (uc->to_ucs.data, uc->from_ucs.data,
+                                    uc->byte_map) != 0)
+        {
+          _free_r (rptr, (_VOID_PTR)uc->byte_map);
+          uc->byte_map = NULL;
+        }
+    }
+#endif
+
   return uc;
 
 error:
@@ -137,6 +156,8 @@ _DEFUN(ucs_based_conversion_close, (rptr, data),
   if (uc->to_ucs.handlers->close != NULL)
     res |= uc->to_ucs.handlers->close (rptr, uc->to_ucs.data);
 
+  if (uc->byte_map != NULL)
+    _free_r (rptr, (_VOID_PTR)uc->byte_map);
   _free_r (rptr, (_VOID_PTR)data);
 
   return res;
@@ -163,8 +184,48 @@ _DEFUN(ucs_based_conversion_convert,
     {
       register size_t bytes;
       register ucs4_t ch;
-      _CONST unsigned char *inbuf_save = *inbuf;
-      size_t inbyteslef_save = *inbytesleft;
+      _CONST unsigned char *inbuf_save;
+      size_t inbyteslef_save;
+
+      if (uc->byte_map != NULL && !(flags & ICONV_DONT_SAVE_BIT))
+        {
+          /*
+           * Convert as many bytes as map directly, four at a time, and
+           * leave the rest to the code below.
+           */
+          _CONST __uint16_t *map = uc->byte_map;
+          _CONST unsigned char *in = *inbuf;
+          unsigned char *out = *outbuf;
+          size_t i, n;
+          __uint16_t c0, c1, c2, c3;
+
+          n = *inbytesleft < *outbytesleft ? *inbytesleft : *outbytesleft;
+          for (i = 0; i + 4 <= n; i += 4)
+            {
+              c0 = map[in[i]];
+              c1 = map[in[i + 1]];
+              c2 = map[in[i + 2]];
+              c3 = map[in[i + 3]];
+              if ((c0 | c1 | c2 | c3) & ICONV_BYTE_MAP_SLOW)
+                break;
+              out[i] = (unsigned char)c0;
+              out[i + 1] = (unsigned char)c1;
+              out[i + 2] = (unsigned char)c2;
+              out[i + 3] = (unsigned char)c3;
+            }
+          for (; i < n && !(map[in[i]] & ICONV_BYTE_MAP_SLOW); i++)
+            out[i] = (unsigned char)map[in[i]];
+
+          *inbuf += i;
+          *inbytesleft -= i;
+          *outbuf += i;
+          *outbytesleft -= i;
+          if (*inbytesleft == 0)
+            break;
+        }
+
+      inbuf_save = *inbuf;
+      inbyteslef_save = *inbytesleft;
 
       if (*outbytesleft == 0)
         {
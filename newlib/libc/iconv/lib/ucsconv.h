@@ -276,6 +276,13 @@ typedef struct
 
   /* UCS -> destination encoding CES converter. */
   iconv_from_ucs_ces_desc_t from_ucs;
+
+  /*
+   * If not NULL, the result of each source byte, when both encodings are
+   * single-byte. Entries with ICONV_BYTE_MAP_SLOW set are converted
+   * character by character.
+   */
+  __uint16_t *byte_map;
 } iconv_ucs_conversion_t;
 
 
@@ -315,6 +322,18 @@ typedef struct
 } iconv_from_ucs_ces_t;
  
 
+/* Marks bytes which can't be converted through byte map */
+#define ICONV_BYTE_MAP_SLOW 0x100
+
+/*
+ * Fill 256-entry byte map for the conversion between two 8-bit CCS
+ * tables. Defined in ces/table.c.
+ */
+int
+_EXFUN(_iconv_table_byte_map, (_VOID_PTR to_data,
+                               _VOID_PTR from_data,
+                               __uint16_t *map));
+
 /* List of "to UCS" linked-in CES converters. */
 extern _CONST iconv_to_ucs_ces_t
 _iconv_to_ucs_ces[];
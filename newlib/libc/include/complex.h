@@ -123,6 +123,12 @@ double complex clog10(double complex);
 float complex clog10f(float complex);
 #endif
 
+#ifdef _ARRAY_MATH_SOURCE
+/* Array versions, see vexp in math.h.  */
+void vcexp(double complex *, const double complex *, size_t);
+void vcexpf(float complex *, const float complex *, size_t);
+#endif
+
 #if defined(__CYGWIN__)
 long double complex cacosl(long double complex);
 long double complex casinl(long double complex);
@@ -581,6 +581,27 @@ extern float pow10l _PARAMS((float));
 #endif /* __CYGWIN__ */
 #endif /* __GNU_VISIBLE */
 
+#ifdef _ARRAY_MATH_SOURCE
+/* Array versions: out[i] = f(in[i]) for each of n elements.  These
+   names are not reserved, so they are only declared on request.  */
+extern void vexp _PARAMS((double *, const double *, size_t));
+extern void vexpf _PARAMS((float *, const float *, size_t));
+extern void vlog _PARAMS((double *, const double *, size_t));
+extern void vlogf _PARAMS((float *, const float *, size_t));
+extern void vsin _PARAMS((double *, const double *, size_t));
+extern void vsinf _PARAMS((float *, const float *, size_t));
+extern void vcos _PARAMS((double *, const double *, size_t));
+extern void vcosf _PARAMS((float *, const float *, size_t));
+extern void vsqrt _PARAMS((double *, const double *, size_t));
+extern void vsqrtf _PARAMS((float *, const float *, size_t));
+extern void vpow _PARAMS((double *, const double *, const double *, size_t));
+extern void vpowf _PARAMS((float *, const float *, const float *, size_t));
+extern void vtanh _PARAMS((double *, const double *, size_t));
+extern void vtanhf _PARAMS((float *, const float *, size_t));
+extern void vsincos _PARAMS((double *, double *, const double *, size_t));
+extern void vsincosf _PARAMS((float *, float *, const float *, size_t));
+#endif /* _ARRAY_MATH_SOURCE */
+
 #if __MISC_VISIBLE || __XSI_VISIBLE
 /* The gamma functions use a global variable, signgam.  */
 #ifndef _REENT_ONLY
@@ -369,6 +369,25 @@ extern void _EXFUN (xdrrec_create, (XDR *, u_int, u_int, void *,
                                     int _EXPARM (, (void *, void *, int)),
                                     int _EXPARM (, (void *, void *, int))));
 
+/*
+ * Scatter/gather element passed to a writev-style xdrrec transport.
+ * Same layout as struct iovec, so writev wrappers can pass it through.
+ */
+struct xdr_iovec
+{
+  void *iov_base;
+  size_t iov_len;
+};
+
+/* send large byte items through a gather-write transport, uncopied */
+extern void _EXFUN (xdrrec_setwritev, (XDR *,
+                                       int _EXPARM (, (void *,
+                                         _CONST struct xdr_iovec *, int)),
+                                       u_int));
+
+/* borrow bytes of the current input fragment in place */
+extern caddr_t _EXFUN (xdrrec_borrowbytes, (XDR *, u_int));
+
 /* make end of xdr record */
 extern bool_t _EXFUN (xdrrec_endofrecord, (XDR *, bool_t));
 
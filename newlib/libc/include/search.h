@@ -33,7 +33,12 @@ typedef enum {
 typedef struct node {
 	char         *key;
 	struct node  *llink, *rlink;
+	unsigned short red;		/* red-black tree colour */
+	unsigned short slot;		/* index in its allocation slab */
 } node_t;
+
+/* A red-black tree of n nodes is at most 2 * log2(n + 1) levels deep. */
+#define	_TSEARCH_MAXDEPTH	(16 * sizeof (void *))
 #endif
 
 struct hsearch_data
@@ -59,6 +64,10 @@ void	tdestroy (void *, void (*)(void *));
 void	*tfind(const void *, void **, __compar_fn_t);
 void	*tsearch(const void *, void **, __compar_fn_t);
 void      twalk(const void *, void (*)(const void *, VISIT, int));
+#ifdef _SEARCH_PRIVATE
+node_t	*__tnode_alloc(void);
+void	 __tnode_free(node_t *);
+#endif
 __END_DECLS
 
 #endif /* !_SEARCH_H_ */
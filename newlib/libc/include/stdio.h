@@ -100,6 +100,7 @@ typedef _fpos64_t fpos64_t;
 
 /* _flags2 flags */
 #define	__SNLK  0x0001		/* stdio functions do not lock streams themselves */
+#define	__SADP  0x0002		/* buffer size adapts to the access pattern */
 #define	__SWID	0x2000		/* true => stream orientation wide, false => byte, only valid if __SORD in _flags is true */
 
 /*
@@ -299,6 +300,7 @@ int	_EXFUN(iprintf, (const char *, ...)
                _ATTRIBUTE ((__format__ (__printf__, 1, 2))));
 int	_EXFUN(iscanf, (const char *, ...)
                _ATTRIBUTE ((__format__ (__scanf__, 1, 2))));
+int	_EXFUN(printf_compile, (const char *));
 int	_EXFUN(siprintf, (char *, const char *, ...)
                _ATTRIBUTE ((__format__ (__printf__, 2, 3))));
 int	_EXFUN(siscanf, (const char *, const char *, ...)
@@ -453,6 +455,7 @@ int	_EXFUN(_iscanf_r, (struct _reent *, const char *, ...)
                _ATTRIBUTE ((__format__ (__scanf__, 2, 3))));
 FILE *	_EXFUN(_open_memstream_r, (struct _reent *, char **, size_t *));
 void	_EXFUN(_perror_r, (struct _reent *, const char *));
+int	_EXFUN(_printf_compile_r, (struct _reent *, const char *));
 int	_EXFUN(_printf_r, (struct _reent *, const char *__restrict, ...)
                _ATTRIBUTE ((__format__ (__printf__, 2, 3))));
 int	_EXFUN(_putc_r, (struct _reent *, int, FILE *));
@@ -17,10 +17,15 @@
 #define	FSETLOCKING_INTERNAL	1
 #define	FSETLOCKING_BYCALLER	2
 
+#define	FSETBUFFERING_QUERY	0
+#define	FSETBUFFERING_FIXED	1
+#define	FSETBUFFERING_ADAPTIVE	2
+
 _BEGIN_STD_C
 
 void	 _EXFUN(__fpurge,(FILE *));
 int	 _EXFUN(__fsetlocking,(FILE *, int));
+int	 _EXFUN(__fsetbuffering,(FILE *, int));
 
 /* TODO:
 
@@ -42,8 +42,7 @@ PORTABILITY
 struct __locale_t *
 _duplocale_r (struct _reent *p, struct __locale_t *locobj)
 {
-  struct __locale_t tmp_locale, *new_locale;
-  int i;
+  struct __locale_t *new_locale;
 
 #ifndef _MB_CAPABLE
   return __get_C_locale ();
@@ -54,41 +53,18 @@ _duplocale_r (struct _reent *p, struct __locale_t *locobj)
   /* The "C" locale is used statically, never copied. */
   else if (locobj == __get_C_locale ())
     return __get_C_locale ();
-  /* Copy locale content. */
-  tmp_locale = *locobj;
-#ifdef __HAVE_LOCALE_INFO__
-  for (i = 1; i < _LC_LAST; ++i)
-    if (locobj->lc_cat[i].buf)
-      {
-	/* If the object is not a "C" locale category, copy it.  Just call
-	   __loadlocale.  It knows what to do to replicate the category. */
-	tmp_locale.lc_cat[i].ptr = NULL;
-	tmp_locale.lc_cat[i].buf = NULL;
-	if (!__loadlocale (&tmp_locale, i, tmp_locale.categories[i]))
-	  goto error;
-      }
-#endif /* __HAVE_LOCALE_INFO__ */
   /* Allocate new locale_t. */
   new_locale = (struct __locale_t *) _calloc_r (p, 1, sizeof *new_locale);
   if (!new_locale)
-    goto error;
-
-  *new_locale = tmp_locale;
-  return new_locale;
-
-error:
-  /* An error occured while we had already (potentially) allocated memory.
-     Free memory and return NULL.  errno is supposed to be set already. */
+    return NULL;
+  /* Copy locale content.  Loaded category data is immutable, so the
+     copy just shares it with LOCOBJ. */
+  *new_locale = *locobj;
 #ifdef __HAVE_LOCALE_INFO__
-  while (--i > 0)
-    if (tmp_locale.lc_cat[i].buf)
-      {
-	_free_r (p, (void *) tmp_locale.lc_cat[i].ptr);
-	_free_r (p, tmp_locale.lc_cat[i].buf);
-      }
+  for (int i = 1; i < _LC_LAST; ++i)
+    __lc_cat_ref (&new_locale->lc_cat[i]);
 #endif /* __HAVE_LOCALE_INFO__ */
-
-  return NULL;
+  return new_locale;
 #endif /* _MB_CAPABLE */
 }
 
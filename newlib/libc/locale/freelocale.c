@@ -47,11 +47,7 @@ _freelocale_r (struct _reent *p, struct __locale_t *locobj)
     return;
 #ifdef __HAVE_LOCALE_INFO__
   for (int i = 1; i < _LC_LAST; ++i)
-    if (locobj->lc_cat[i].buf)
-      {
-	_free_r (p, (void *) locobj->lc_cat[i].ptr);
-	_free_r (p, locobj->lc_cat[i].buf);
-      }
+    __lc_cat_unref (&locobj->lc_cat[i]);
 #endif /* __HAVE_LOCALE_INFO__ */
   _free_r (p, locobj);
 #endif /* _MB_CAPABLE */
@@ -61,7 +61,7 @@ __ctype_load_locale (struct __locale_t *locale, const char *name,
 
       if (ret > 0)
 	{
-	  ctp = (struct lc_ctype_T *) calloc (1, sizeof *ctp);
+	  ctp = (struct lc_ctype_T *) __lc_cat_alloc (sizeof *ctp);
 	  if (!ctp)
 	    {
 	      free (bufp);
@@ -72,12 +72,8 @@ __ctype_load_locale (struct __locale_t *locale, const char *name,
       struct __lc_cats tmp = locale->lc_cat[LC_CTYPE];
       locale->lc_cat[LC_CTYPE].ptr = ret == 0 ? &_C_ctype_locale : ctp;
       locale->lc_cat[LC_CTYPE].buf = bufp;
-      /* If buf is not NULL, both pointers have been alloc'ed */
-      if (tmp.buf)
-	{
-	  free ((void *) tmp.ptr);
-	  free (tmp.buf);
-	}
+      /* Other locale objects may still share the old data. */
+      __lc_cat_unref (&tmp);
       ret = 0;
     }
 #else
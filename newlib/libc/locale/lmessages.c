@@ -80,7 +80,7 @@ __messages_load_locale (struct __locale_t *locale, const char *name,
 
       if (ret > 0)
 	{
-	  mep = (struct lc_messages_T *) calloc (1, sizeof *mep);
+	  mep = (struct lc_messages_T *) __lc_cat_alloc (sizeof *mep);
 	  if (!mep)
 	    {
 	      free (bufp);
@@ -91,12 +91,8 @@ __messages_load_locale (struct __locale_t *locale, const char *name,
       struct __lc_cats tmp = locale->lc_cat[LC_MESSAGES];
       locale->lc_cat[LC_MESSAGES].ptr = ret == 0 ? &_C_messages_locale : mep;
       locale->lc_cat[LC_MESSAGES].buf = bufp;
-      /* If buf is not NULL, both pointers have been alloc'ed */
-      if (tmp.buf)
-	{
-	  free ((void *) tmp.ptr);
-	  free (tmp.buf);
-	}
+      /* Other locale objects may still share the old data. */
+      __lc_cat_unref (&tmp);
       ret = 0;
     }
 #else
@@ -107,7 +107,7 @@ __monetary_load_locale (struct __locale_t *locale, const char *name ,
 
       if (ret > 0)
 	{
-	  mop = (struct lc_monetary_T *) calloc (1, sizeof *mop);
+	  mop = (struct lc_monetary_T *) __lc_cat_alloc (sizeof *mop);
 	  if (!mop)
 	    {
 	      free (bufp);
@@ -118,12 +118,8 @@ __monetary_load_locale (struct __locale_t *locale, const char *name ,
       struct __lc_cats tmp = locale->lc_cat[LC_MONETARY];
       locale->lc_cat[LC_MONETARY].ptr = ret == 0 ? &_C_monetary_locale : mop;
       locale->lc_cat[LC_MONETARY].buf = bufp;
-      /* If buf is not NULL, both pointers have been alloc'ed */
-      if (tmp.buf)
-	{
-	  free ((void *) tmp.ptr);
-	  free (tmp.buf);
-	}
+      /* Other locale objects may still share the old data. */
+      __lc_cat_unref (&tmp);
       ret = 0;
     }
 #else
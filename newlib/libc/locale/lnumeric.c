@@ -63,7 +63,7 @@ __numeric_load_locale (struct __locale_t *locale, const char *name ,
 
       if (ret > 0)
 	{
-	  nmp = (struct lc_numeric_T *) calloc (1, sizeof *nmp);
+	  nmp = (struct lc_numeric_T *) __lc_cat_alloc (sizeof *nmp);
 	  if (!nmp)
 	    {
 	      free (bufp);
@@ -74,12 +74,8 @@ __numeric_load_locale (struct __locale_t *locale, const char *name ,
       struct __lc_cats tmp = locale->lc_cat[LC_NUMERIC];
       locale->lc_cat[LC_NUMERIC].ptr = ret == 0 ? &_C_numeric_locale : nmp;
       locale->lc_cat[LC_NUMERIC].buf = bufp;
-      /* If buf is not NULL, both pointers have been alloc'ed */
-      if (tmp.buf)
-	{
-	  free ((void *) tmp.ptr);
-	  free (tmp.buf);
-	}
+      /* Other locale objects may still share the old data. */
+      __lc_cat_unref (&tmp);
       ret = 0;
     }
 #else
@@ -953,6 +953,55 @@ restart:
   return strcpy(loc->categories[category], new_locale);
 }
 
+#ifdef __HAVE_LOCALE_INFO__
+/* Header in front of shared category data.  The union keeps the data
+   following it suitably aligned. */
+union lc_cat_hdr
+{
+  unsigned int refs;
+  void *align_p;
+  long long align_ll;
+  double align_d;
+};
+
+#define LC_CAT_HDR(_ptr) ((union lc_cat_hdr *) (_ptr) - 1)
+
+/* Allocate zeroed category data with a reference count of 1. */
+void *
+__lc_cat_alloc (size_t size)
+{
+  union lc_cat_hdr *hdr;
+
+  hdr = (union lc_cat_hdr *) calloc (1, sizeof *hdr + size);
+  if (!hdr)
+    return NULL;
+  hdr->refs = 1;
+  return hdr + 1;
+}
+
+/* Take another reference to CAT's data.  Taking one only requires that
+   the caller already holds one, so no ordering is needed. */
+void
+__lc_cat_ref (struct __lc_cats *cat)
+{
+  if (cat->buf)
+    __atomic_add_fetch (&LC_CAT_HDR (cat->ptr)->refs, 1, __ATOMIC_RELAXED);
+}
+
+/* Drop a reference to CAT's data, freeing it with the last one. */
+void
+__lc_cat_unref (struct __lc_cats *cat)
+{
+  if (cat->buf
+      && __atomic_sub_fetch (&LC_CAT_HDR (cat->ptr)->refs, 1,
+			     __ATOMIC_ACQ_REL) == 0)
+    {
+      free (LC_CAT_HDR (cat->ptr));
+      free (cat->buf);
+    }
+}
+#endif /* __HAVE_LOCALE_INFO__ */
+
 const char *
 __get_locale_env (struct _reent *p, int category)
 {
@@ -92,6 +92,9 @@ _newlocale_r (struct _reent *p, int category_mask, const char *locale,
   char new_categories[_LC_LAST][ENCODING_LEN + 1];
   struct __locale_t tmp_locale, *new_locale;
   int i;
+#ifdef __HAVE_LOCALE_INFO__
+  int shared = 0;
+#endif
 
   /* Convert LC_ALL_MASK to a mask containing all valid MASK values.
      This simplifies the code below. */
@@ -147,14 +150,14 @@ _newlocale_r (struct _reent *p, int category_mask, const char *locale,
 	      tmp_locale.wctomb = base->wctomb;
 	      tmp_locale.mbtowc = base->mbtowc;
 	      tmp_locale.cjk_lang = base->cjk_lang;
-	      tmp_locale.ctype_ptr - base->ctype_ptr;
+	      tmp_locale.ctype_ptr = base->ctype_ptr;
 	    }
 #ifdef __HAVE_LOCALE_INFO__
-	  /* Mark the values as "has still to be copied".  We do this in
-	     two steps to simplify freeing new locale types in case of a
-	     subsequent error. */
-	  tmp_locale.lc_cat[i].ptr = base->lc_cat[i].ptr;
-	  tmp_locale.lc_cat[i].buf = (void *) -1;
+	  /* Share the data with base.  The reference is only taken once
+	     the new locale is complete, which simplifies freeing new
+	     locale types in case of a subsequent error. */
+	  tmp_locale.lc_cat[i] = base->lc_cat[i];
+	  shared |= 1 << i;
 #else /* !__HAVE_LOCALE_INFO__ */
 	  if (i == LC_CTYPE)
 	    strcpy (tmp_locale.ctype_codeset, base->ctype_codeset);
@@ -181,15 +184,10 @@ _newlocale_r (struct _reent *p, int category_mask, const char *locale,
   if (base)
     {
 #ifdef __HAVE_LOCALE_INFO__
-      /* Step 2 of copying over..  Make sure to invalidate the copied buffer
-	 pointers in base, so the subsequent _freelocale_r (base) doesn't free
-	 the buffers now used in the new locale. */
+      /* Keep the shared data alive when base is freed. */
       for (i = 1; i < _LC_LAST; ++i)
-	if (tmp_locale.lc_cat[i].buf == (const void *) -1)
-	  {
-	    tmp_locale.lc_cat[i].buf = base->lc_cat[i].buf;
-	    base->lc_cat[i].ptr = base->lc_cat[i].buf = NULL;
-	  }
+	if (shared & (1 << i))
+	  __lc_cat_ref (&tmp_locale.lc_cat[i]);
 #endif /* __HAVE_LOCALE_INFO__ */
       _freelocale_r (p, base);
     }
@@ -202,13 +200,8 @@ error:
      Free memory and return NULL.  errno is supposed to be set already. */
 #ifdef __HAVE_LOCALE_INFO__
   for (i = 1; i < _LC_LAST; ++i)
-    if (((1 << i) & category_mask) != 0
-	&& tmp_locale.lc_cat[i].buf
-	&& tmp_locale.lc_cat[i].buf != (const void *) -1)
-      {
-	_free_r (p, (void *) tmp_locale.lc_cat[i].ptr);
-	_free_r (p, tmp_locale.lc_cat[i].buf);
-      }
+    if ((shared & (1 << i)) == 0)
+      __lc_cat_unref (&tmp_locale.lc_cat[i]);
 #endif /* __HAVE_LOCALE_INFO__ */
 
   return NULL;
@@ -169,6 +169,11 @@ struct	lc_messages_T
 };
 extern const struct lc_messages_T _C_messages_locale;
 
+/* Loaded category data is never modified once it has been stored in a
+   locale's lc_cat[], so locale objects share it rather than copying it.
+   If buf is not NULL, ptr has been allocated with __lc_cat_alloc and is
+   reference counted, and buf is freed together with it.  Otherwise ptr
+   points to static "C" locale data. */
 struct __lc_cats
 {
   const void	*ptr;
@@ -194,6 +199,12 @@ struct __locale_t
 #endif
 };
 
+#ifdef __HAVE_LOCALE_INFO__
+extern void *__lc_cat_alloc (size_t);
+extern void __lc_cat_ref (struct __lc_cats *);
+extern void __lc_cat_unref (struct __lc_cats *);
+#endif /* __HAVE_LOCALE_INFO__ */
+
 #ifdef _MB_CAPABLE
 extern char *__loadlocale (struct __locale_t *, int, const char *);
 extern const char *__get_locale_env(struct _reent *, int);
@@ -164,7 +164,7 @@ __time_load_locale (struct __locale_t *locale, const char *name,
 
       if (ret > 0)
 	{
-	  tip = (struct lc_time_T *) calloc (1, sizeof *tip);
+	  tip = (struct lc_time_T *) __lc_cat_alloc (sizeof *tip);
 	  if (!tip)
 	    {
 	      free (bufp);
@@ -175,12 +175,8 @@ __time_load_locale (struct __locale_t *locale, const char *name,
       struct __lc_cats tmp = locale->lc_cat[LC_TIME];
       locale->lc_cat[LC_TIME].ptr = ret == 0 ? &_C_time_locale : tip;
       locale->lc_cat[LC_TIME].buf = bufp;
-      /* If buf is not NULL, both pointers have been alloc'ed */
-      if (tmp.buf)
-	{
-	  free ((void *) tmp.ptr);
-	  free (tmp.buf);
-	}
+      /* Other locale objects may still share the old data. */
+      __lc_cat_unref (&tmp);
       ret = 0;
     }
 #else
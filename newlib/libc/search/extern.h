@@ -52,14 +52,19 @@ __uint16_t	 __find_last_page(HTAB *, BUFHEAD **);
 void	 __free_ovflpage(HTAB *, BUFHEAD *);
 BUFHEAD	*__get_buf(HTAB *, __uint32_t, BUFHEAD *, int);
 int	 __get_page(HTAB *, char *, __uint32_t, int, int, int);
+ssize_t	 __hash_pread(int, void *, size_t, off_t);
+ssize_t	 __hash_pwrite(int, const void *, size_t, off_t);
 int	 __ibitmap(HTAB *, int, int, int);
 __uint32_t	 __log2(__uint32_t);
 int	 __put_page(HTAB *, char *, __uint32_t, int, int);
+int	 __put_pages(HTAB *, char *, __uint32_t, int);
 void	 __reclaim_buf(HTAB *, BUFHEAD *);
 int	 __split_page(HTAB *, __uint32_t, __uint32_t);
 
 /* Default hash routine. */
 extern __uint32_t (*__default_hash)(const void *, size_t);
+extern __uint32_t (*__compat_hash)(const void *, size_t);
+__uint32_t	 __hash_seed(const void *, size_t, __uint32_t);
 
 #ifdef HASH_STATISTICS
 extern int hash_accesses, hash_collisions, hash_expansions, hash_overflows;
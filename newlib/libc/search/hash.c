@@ -192,8 +192,14 @@ _DEFUN(__hash_open, (file, flags, mode, info, dflags),
 		if (hashp->HASH_VERSION != HASHVERSION &&
 		    hashp->HASH_VERSION != OLDHASHVERSION)
 			RETURN_ERROR(EFTYPE, error1);
-		if (hashp->hash(CHARKEY, sizeof(CHARKEY)) != hashp->H_CHARKEY)
-			RETURN_ERROR(EFTYPE, error1);
+		if (hashp->hash(CHARKEY, sizeof(CHARKEY)) != hashp->H_CHARKEY) {
+			/* Maybe built with the previous default hash. */
+			if ((info && info->hash) ||
+			    __compat_hash(CHARKEY, sizeof(CHARKEY)) !=
+			    hashp->H_CHARKEY)
+				RETURN_ERROR(EFTYPE, error1);
+			hashp->hash = __compat_hash;
+		}
 		/*
 		 * Figure out how many segments we need.  Max_Bucket is the
 		 * maximum bucket number, so the number of buckets is
@@ -542,8 +548,7 @@ flush_meta(hashp)
 	whdrp = &whdr;
 	swap_header_copy(&hashp->hdr, whdrp);
 #endif
-	if ((lseek(fp, (off_t)0, SEEK_SET) == -1) ||
-	    ((wsize = write(fp, whdrp, sizeof(HASHHDR))) == -1))
+	if ((wsize = __hash_pwrite(fp, whdrp, sizeof(HASHHDR), (off_t)0)) == -1)
 		return (-1);
 	else
 		if (wsize != sizeof(HASHHDR)) {
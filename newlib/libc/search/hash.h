@@ -143,7 +143,7 @@ typedef struct htab	 {		/* Memory resident data structure */
 #define	MAX_BSIZE		65536		/* 2^16 */
 #define MIN_BUFFERS		6
 #define MINHDRSIZE		512
-#define DEF_BUFSIZE		65536		/* 64 K */
+#define DEF_BUFSIZE		262144		/* 256 K, allocated as used */
 #define DEF_BUCKET_SIZE		4096
 #define DEF_BUCKET_SHIFT	12		/* log2(BUCKET) */
 #define DEF_SEGSIZE		256
@@ -54,6 +54,7 @@ static char sccsid[] = "@(#)hash_buf.c	8.5 (Berkeley) 7/15/94";
  *	__reclaim_buf
  * Internal
  *	newbuf
+ *	buf_flush
  */
 
 #include <sys/param.h>
@@ -61,6 +62,7 @@ static char sccsid[] = "@(#)hash_buf.c	8.5 (Berkeley) 7/15/94";
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef DEBUG
 #include <assert.h>
@@ -72,6 +74,10 @@ static char sccsid[] = "@(#)hash_buf.c	8.5 (Berkeley) 7/15/94";
 #include "extern.h"
 
 static BUFHEAD *newbuf(HTAB *, __uint32_t, BUFHEAD *);
+static int buf_flush(HTAB *);
+
+/* Largest single write buf_flush gathers adjacent dirty pages into. */
+#define	FLUSH_BATCH	65536
 
 /* Unlink B from its place in the lru */
 #define BUF_REMOVE(B) { \
@@ -330,6 +336,12 @@ __buf_free(hashp, do_free, to_disk)
 	/* Need to make sure that buffer manager has been initialized */
 	if (!LRU)
 		return (0);
+	/*
+	 * Write the modified pages in file order first.  If that can't get
+	 * the memory it needs, the loop below writes them one by one.
+	 */
+	if (to_disk && buf_flush(hashp) == -1)
+		return (-1);
 	for (bp = LRU; bp != &hashp->bufhead;) {
 		/* Check that the buffer is valid */
 		if (bp->addr || IS_BUCKET(bp->flags)) {
@@ -351,6 +363,99 @@ __buf_free(hashp, do_free, to_disk)
 	return (0);
 }
 
+struct dirty {
+	__uint32_t	page;		/* Page number in the file */
+	BUFHEAD		*bp;
+};
+
+static int
+dirty_cmp(a, b)
+	const void *a, *b;
+{
+	__uint32_t pa = ((const struct dirty *)a)->page;
+	__uint32_t pb = ((const struct dirty *)b)->page;
+
+	return (pa < pb ? -1 : pa > pb);
+}
+
+/*
+ * Write back all modified buffers, sorted by page number, copying runs of
+ * pages that are adjacent in the file into one buffer of up to
+ * FLUSH_BATCH bytes so that each run takes a single write.  Since the
+ * copies rather than the buffers get byte swapped, the buffers stay valid
+ * and are marked clean.
+ *
+ * Returns:
+ *	 0 ==> OK
+ *	 1 ==> no memory, nothing written
+ *	-1 ==> write error
+ */
+static int
+buf_flush(hashp)
+	HTAB *hashp;
+{
+	struct dirty *d;
+	BUFHEAD *bp;
+	SEGMENT segp;
+	char *stage;
+	int i, j, k, n, nstage;
+
+	n = 0;
+	for (bp = LRU; bp != &hashp->bufhead; bp = bp->prev)
+		if ((bp->addr || IS_BUCKET(bp->flags)) && (bp->flags & BUF_MOD))
+			n++;
+	if (n == 0)
+		return (0);
+
+	nstage = MAX(FLUSH_BATCH >> hashp->BSHIFT, 1);
+	d = (struct dirty *)malloc(n * sizeof(struct dirty));
+	stage = (char *)malloc(MIN(n, nstage) << hashp->BSHIFT);
+	if (d == NULL || stage == NULL) {
+		free(d);
+		free(stage);
+		return (1);
+	}
+	n = 0;
+	for (bp = LRU; bp != &hashp->bufhead; bp = bp->prev)
+		if ((bp->addr || IS_BUCKET(bp->flags)) &&
+		    (bp->flags & BUF_MOD)) {
+			if (IS_BUCKET(bp->flags))
+				d[n].page = BUCKET_TO_PAGE(bp->addr);
+			else
+				d[n].page = OADDR_TO_PAGE(bp->addr);
+			d[n++].bp = bp;
+		}
+	qsort(d, n, sizeof(struct dirty), dirty_cmp);
+
+	for (i = 0; i < n; i = j) {
+		for (j = i; j < n && j - i < nstage &&
+		    d[j].page == d[i].page + (j - i); j++)
+			memcpy(stage + ((j - i) << hashp->BSHIFT),
+			    d[j].bp->page, hashp->BSIZE);
+		if (__put_pages(hashp, stage, d[i].page, j - i)) {
+			free(d);
+			free(stage);
+			return (-1);
+		}
+		for (k = i; k < j; k++) {
+			bp = d[k].bp;
+			bp->flags &= ~BUF_MOD;
+			/*
+			 * The bucket is on disk now; make sure it is read
+			 * back from there once its buffer is evicted.
+			 */
+			if (IS_BUCKET(bp->flags)) {
+				segp = hashp->dir[bp->addr >> hashp->SSHIFT];
+				segp[bp->addr & (hashp->SGSIZE - 1)] =
+				    (BUFHEAD *)((ptrdiff_t)bp | BUF_DISK);
+			}
+		}
+	}
+	free(d);
+	free(stage);
+	return (0);
+}
+
 extern void
 __reclaim_buf(hashp, bp)
 	HTAB *hashp;
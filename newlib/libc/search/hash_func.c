@@ -51,9 +51,13 @@ static __uint32_t hash2(const void *, size_t);
 static __uint32_t hash3(const void *, size_t);
 #endif
 static __uint32_t hash4(const void *, size_t);
+static __uint32_t hash5(const void *, size_t);
 
 /* Global default hash function */
-__uint32_t (*__default_hash)(const void *, size_t) = hash4;
+__uint32_t (*__default_hash)(const void *, size_t) = hash5;
+
+/* The default before hash5; existing tables may have been built with it */
+__uint32_t (*__compat_hash)(const void *, size_t) = hash4;
 
 /*
  * HASH FUNCTIONS
@@ -218,3 +222,77 @@ hash4(keyarg, len)
 	}
 	return (h);
 }
+
+/*
+ * xxHash32, by Yann Collet.  All arithmetic is 32-bit, so it is cheap
+ * on every target, and unlike hash4 every bit of the key affects the
+ * low bits of the result, which are the ones used to pick a bucket.
+ * Keys are read a byte at a time and assembled little-endian, so the
+ * value does not depend on alignment or byte order.
+ */
+#define	XXH_PRIME1	0x9e3779b1U
+#define	XXH_PRIME2	0x85ebca77U
+#define	XXH_PRIME3	0xc2b2ae3dU
+#define	XXH_PRIME4	0x27d4eb2fU
+#define	XXH_PRIME5	0x165667b1U
+
+#define	XXH_ROTL(x, r)	(((x) << (r)) | ((x) >> (32 - (r))))
+#define	XXH_READ(p)	((__uint32_t)(p)[0] | (__uint32_t)(p)[1] << 8 | \
+			 (__uint32_t)(p)[2] << 16 | (__uint32_t)(p)[3] << 24)
+#define	XXH_ROUND(v, p)	((v) += XXH_READ(p) * XXH_PRIME2, \
+			 (v) = XXH_ROTL(v, 13) * XXH_PRIME1)
+
+__uint32_t
+__hash_seed(keyarg, len, seed)
+	const void *keyarg;
+	size_t len;
+	__uint32_t seed;
+{
+	const u_char *key, *end;
+	__uint32_t h, v1, v2, v3, v4;
+
+	key = keyarg;
+	end = key + len;
+	if (len >= 16) {
+		v1 = seed + XXH_PRIME1 + XXH_PRIME2;
+		v2 = seed + XXH_PRIME2;
+		v3 = seed;
+		v4 = seed - XXH_PRIME1;
+		do {
+			XXH_ROUND(v1, key);
+			XXH_ROUND(v2, key + 4);
+			XXH_ROUND(v3, key + 8);
+			XXH_ROUND(v4, key + 12);
+			key += 16;
+		} while (end - key >= 16);
+		h = XXH_ROTL(v1, 1) + XXH_ROTL(v2, 7) +
+		    XXH_ROTL(v3, 12) + XXH_ROTL(v4, 18);
+	} else
+		h = seed + XXH_PRIME5;
+	h += (__uint32_t)len;
+
+	for (; end - key >= 4; key += 4) {
+		h += XXH_READ(key) * XXH_PRIME3;
+		h = XXH_ROTL(h, 17) * XXH_PRIME4;
+	}
+	while (key < end) {
+		h += *key++ * XXH_PRIME5;
+		h = XXH_ROTL(h, 11) * XXH_PRIME1;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME2;
+	h ^= h >> 13;
+	h *= XXH_PRIME3;
+	h ^= h >> 16;
+	return (h);
+}
+
+/* xxHash32 with a fixed seed, so that on-disk tables stay readable. */
+static __uint32_t
+hash5(keyarg, len)
+	const void *keyarg;
+	size_t len;
+{
+	return (__hash_seed(keyarg, len, 0));
+}
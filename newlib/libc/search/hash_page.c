@@ -50,10 +50,15 @@ static char sccsid[] = "@(#)hash_page.c	8.7 (Berkeley) 8/16/94";
  *
  * External
  *	__get_page
+ *	__put_page
+ *	__put_pages
  *	__add_ovflpage
+ *	__hash_pread
+ *	__hash_pwrite
  * Internal
  *	overflow_page
  *	open_temp
+ *	swap_page_out
  */
 
 #include <sys/types.h>
@@ -80,6 +85,7 @@ static int	 open_temp(HTAB *);
 static __uint16_t	 overflow_page(HTAB *);
 static void	 putpair(char *, const DBT *, const DBT *);
 static void	 squeeze_key(__uint16_t *, const DBT *, const DBT *);
+static void	 swap_page_out(HTAB *, char *, int);
 static int	 ugly_split
 (HTAB *, __uint32_t, BUFHEAD *, BUFHEAD *, int, int);
 
@@ -538,8 +544,8 @@ __get_page(hashp, p, bucket, is_bucket, is_disk, is_bitmap)
 		page = BUCKET_TO_PAGE(bucket);
 	else
 		page = OADDR_TO_PAGE(bucket);
-	if ((lseek(fd, (off_t)page << hashp->BSHIFT, SEEK_SET) == -1) ||
-	    ((rsize = read(fd, p, size)) == -1))
+	if ((rsize = __hash_pread(fd, p, size,
+	    (off_t)page << hashp->BSHIFT)) == -1)
 		return (-1);
 	bp = (__uint16_t *)p;
 	if (!rsize)
@@ -591,26 +597,17 @@ __put_page(hashp, p, bucket, is_bucket, is_bitmap)
 		return (-1);
 	fd = hashp->fp;
 
-       if (hashp->LORDER != DB_BYTE_ORDER) {
-		int i;
-		int max;
-
-		if (is_bitmap) {
-			max = hashp->BSIZE >> 2;	/* divide by 4 */
-			for (i = 0; i < max; i++)
-				M_32_SWAP(((int *)p)[i]);
-		} else {
-			max = ((__uint16_t *)p)[0] + 2;
-			for (i = 0; i <= max; i++)
-				M_16_SWAP(((__uint16_t *)p)[i]);
-		}
-	}
+	if (hashp->LORDER != DB_BYTE_ORDER)
+		swap_page_out(hashp, p, is_bitmap);
 	if (is_bucket)
 		page = BUCKET_TO_PAGE(bucket);
 	else
 		page = OADDR_TO_PAGE(bucket);
-	if ((lseek(fd, (off_t)page << hashp->BSHIFT, SEEK_SET) == -1) ||
-	    ((wsize = write(fd, p, size)) == -1))
+	wsize = __hash_pwrite(fd, p, size, (off_t)page << hashp->BSHIFT);
+	/* Bitmap pages stay in memory, so put them back in host order. */
+	if (hashp->LORDER != DB_BYTE_ORDER && is_bitmap)
+		swap_page_out(hashp, p, is_bitmap);
+	if (wsize == -1)
 		/* Errno is set */
 		return (-1);
 	if (wsize != size) {
@@ -620,6 +617,100 @@ __put_page(hashp, p, bucket, is_bucket, is_bitmap)
 	return (0);
 }
 
+/*
+ * Write npages pages that are consecutive on disk, starting at page, with
+ * a single call.  Like __put_page, this byte swaps the pages in p.
+ *
+ * Returns:
+ *	 0 ==> OK
+ *	-1 ==>failure
+ */
+extern int
+__put_pages(hashp, p, page, npages)
+	HTAB *hashp;
+	char *p;
+	__uint32_t page;
+	int npages;
+{
+	int i, size;
+	ssize_t wsize;
+
+	size = npages << hashp->BSHIFT;
+	if ((hashp->fp == -1) && open_temp(hashp))
+		return (-1);
+
+	if (hashp->LORDER != DB_BYTE_ORDER)
+		for (i = 0; i < npages; i++)
+			swap_page_out(hashp, p + (i << hashp->BSHIFT), 0);
+	if ((wsize = __hash_pwrite(hashp->fp, p, size,
+	    (off_t)page << hashp->BSHIFT)) == -1)
+		return (-1);
+	if (wsize != size) {
+		errno = EFTYPE;
+		return (-1);
+	}
+	return (0);
+}
+
+/*
+ * Convert a page in host byte order to the byte order of the file.
+ */
+static void
+swap_page_out(hashp, p, is_bitmap)
+	HTAB *hashp;
+	char *p;
+	int is_bitmap;
+{
+	int i, max;
+
+	if (is_bitmap) {
+		max = hashp->BSIZE >> 2;	/* divide by 4 */
+		for (i = 0; i < max; i++)
+			M_32_SWAP(((int *)p)[i]);
+	} else {
+		max = ((__uint16_t *)p)[0] + 2;
+		for (i = 0; i <= max; i++)
+			M_16_SWAP(((__uint16_t *)p)[i]);
+	}
+}
+
+/*
+ * Positional reads and writes of the backing file.  Without pread and
+ * pwrite, seek first; nothing in the hash package relies on the file
+ * offset between calls.
+ */
+extern ssize_t
+__hash_pread(fd, p, size, off)
+	int fd;
+	void *p;
+	size_t size;
+	off_t off;
+{
+#ifdef HAVE_PREAD
+	return (pread(fd, p, size, off));
+#else
+	if (lseek(fd, off, SEEK_SET) == -1)
+		return (-1);
+	return (read(fd, p, size));
+#endif
+}
+
+extern ssize_t
+__hash_pwrite(fd, p, size, off)
+	int fd;
+	const void *p;
+	size_t size;
+	off_t off;
+{
+#ifdef HAVE_PREAD
+	return (pwrite(fd, p, size, off));
+#else
+	if (lseek(fd, off, SEEK_SET) == -1)
+		return (-1);
+	return (write(fd, p, size));
+#endif
+}
+
 #define BYTE_MASK	((1 << INT_BYTE_SHIFT) -1)
 /*
  * Initialize a new bitmap page.  Bitmap pages are left in memory
@@ -75,8 +75,8 @@ SLIST_HEAD(internal_head, internal_entry);
 #define	MAX_BUCKETS_LG2	(sizeof (size_t) * 8 - 1 - 5)
 #define	MAX_BUCKETS	((size_t)1 << MAX_BUCKETS_LG2)
 
-/* Default hash function, from db/hash/hash_func.c */
-extern __uint32_t (*__default_hash)(const void *, size_t);
+/* Seeded hash function, from db/hash/hash_func.c */
+extern __uint32_t __hash_seed(const void *, size_t, __uint32_t);
 
 int
 hcreate_r(size_t nel, struct hsearch_data *htab)
@@ -152,8 +152,14 @@ hsearch_r(ENTRY item, ACTION action, ENTRY **retval, struct hsearch_data *htab)
 	__uint32_t hashval;
 	size_t len;
 
+	/*
+	 * Seed with the table address.  Tables need not hash alike, and
+	 * this keeps a fixed set of colliding keys from being colliding
+	 * keys for every table in every program.
+	 */
 	len = strlen(item.key);
-	hashval = (*__default_hash)(item.key, len);
+	hashval = __hash_seed(item.key, len,
+	    (__uint32_t)((size_t)htab->htable >> 4));
 
         head = &(htab->htable[hashval & (htab->htablesize - 1)]);
 	ie = SLIST_FIRST(head);
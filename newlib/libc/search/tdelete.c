@@ -31,37 +31,140 @@ _DEFUN(tdelete, (vkey, vrootp, compar),
 	void      **__restrict vrootp _AND	/* address of the root of tree */
 	int       (*compar)(const void *, const void *))
 {
-	node_t **rootp = (node_t **)vrootp;
-	node_t *p, *q, *r;
-	int  cmp;
+	node_t **path[_TSEARCH_MAXDEPTH + 2];	/* links from the root down */
+	node_t *parent, *z, *y, *x, *p, *s, *t;
+	int n = 0, zn, cmp, red;
 
-	if (rootp == NULL || (p = *rootp) == NULL)
+	if (vrootp == NULL || *(node_t **)vrootp == NULL)
 		return NULL;
 
-	while ((cmp = (*compar)(vkey, (*rootp)->key)) != 0) {
-		p = *rootp;
-		rootp = (cmp < 0) ?
-		    &(*rootp)->llink :		/* follow llink branch */
-		    &(*rootp)->rlink;		/* follow rlink branch */
-		if (*rootp == NULL)
+	path[0] = (node_t **)vrootp;
+	while ((cmp = (*compar)(vkey, (*path[n])->key)) != 0) {
+		path[n + 1] = (cmp < 0) ?
+		    &(*path[n])->llink :	/* follow llink branch */
+		    &(*path[n])->rlink;		/* follow rlink branch */
+		n++;
+		if (*path[n] == NULL)
 			return NULL;		/* key not found */
 	}
-	r = (*rootp)->rlink;			/* D1: */
-	if ((q = (*rootp)->llink) == NULL)	/* Left NULL? */
-		q = r;
-	else if (r != NULL) {			/* Right link is NULL? */
-		if (r->llink == NULL) {		/* D2: Find successor */
-			r->llink = q;
-			q = r;
-		} else {			/* D3: Find NULL link */
-			for (q = r->llink; q->llink != NULL; q = r->llink)
-				r = q;
-			r->llink = q->rlink;
-			q->llink = (*rootp)->llink;
-			q->rlink = (*rootp)->rlink;
+	z = *path[n];
+	parent = n > 0 ? *path[n - 1] : (node_t *)vrootp;
+
+	/*
+	 * If z has two children, move its successor y into its place, and
+	 * z into y's, so that z has at most one child.  Nodes are relinked
+	 * rather than keys copied, as callers may hold pointers to them.
+	 */
+	if (z->llink != NULL && z->rlink != NULL) {
+		zn = n;
+		path[++n] = &z->rlink;
+		while ((*path[n])->llink != NULL) {
+			path[n + 1] = &(*path[n])->llink;
+			n++;
+		}
+		y = *path[n];
+		*path[zn] = y;
+		x = y->rlink;
+		y->llink = z->llink;
+		if (n == zn + 1)
+			y->rlink = z;
+		else {
+			y->rlink = z->rlink;
+			*path[n] = z;
+		}
+		path[zn + 1] = &y->rlink;
+		z->llink = NULL;
+		z->rlink = x;
+		red = y->red;
+		y->red = z->red;
+		z->red = red;
+	}
+
+	/* Unlink z. */
+	x = z->llink != NULL ? z->llink : z->rlink;
+	*path[n] = x;
+	red = z->red;
+	__tnode_free(z);
+	if (red)
+		return parent;
+
+	/*
+	 * A black node was removed, so the subtree at depth n is one black
+	 * node short.  Fix that as in CLR, with s the sibling of x and p
+	 * their parent.  A black x always has a sibling.
+	 */
+	while (n > 0 && (x == NULL || !x->red)) {
+		p = *path[n - 1];
+		if (path[n] == &p->llink) {
+			s = p->rlink;
+			if (s->red) {		/* make the sibling black */
+				s->red = 0;
+				p->red = 1;
+				*path[n - 1] = s;
+				p->rlink = s->llink;
+				s->llink = p;
+				path[n] = &s->llink;
+				path[++n] = &p->llink;
+				s = p->rlink;
+			}
+			if ((s->llink == NULL || !s->llink->red)
+			    && (s->rlink == NULL || !s->rlink->red)) {
+				s->red = 1;
+				x = p;
+				n--;
+				continue;
+			}
+			if (s->rlink == NULL || !s->rlink->red) {
+				t = s->llink;
+				t->red = 0;
+				s->red = 1;
+				s->llink = t->rlink;
+				t->rlink = s;
+				p->rlink = s = t;
+			}
+			s->red = p->red;
+			p->red = 0;
+			s->rlink->red = 0;
+			*path[n - 1] = s;
+			p->rlink = s->llink;
+			s->llink = p;
+		} else {
+			s = p->llink;
+			if (s->red) {
+				s->red = 0;
+				p->red = 1;
+				*path[n - 1] = s;
+				p->llink = s->rlink;
+				s->rlink = p;
+				path[n] = &s->rlink;
+				path[++n] = &p->rlink;
+				s = p->llink;
+			}
+			if ((s->llink == NULL || !s->llink->red)
+			    && (s->rlink == NULL || !s->rlink->red)) {
+				s->red = 1;
+				x = p;
+				n--;
+				continue;
+			}
+			if (s->llink == NULL || !s->llink->red) {
+				t = s->rlink;
+				t->red = 0;
+				s->red = 1;
+				s->rlink = t->llink;
+				t->llink = s;
+				p->llink = s = t;
+			}
+			s->red = p->red;
+			p->red = 0;
+			s->llink->red = 0;
+			*path[n - 1] = s;
+			p->llink = s->rlink;
+			s->rlink = p;
 		}
+		return parent;
 	}
-	free(*rootp);				/* D4: Free node */
-	*rootp = q;				/* link parent to new node */
-	return p;
+	if (x != NULL)
+		x->red = 0;
+	return parent;
 }
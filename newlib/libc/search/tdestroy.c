@@ -24,28 +24,33 @@ __RCSID("$NetBSD: tdelete.c,v 1.2 1999/09/16 11:45:37 lukem Exp $");
 #include <stdlib.h>
 
 
-/* Walk the nodes of a tree */
-static void
-trecurse(root, free_action)
-	node_t *root;	/* Root of the tree to be walked */
-	void (*free_action)(void *);
-{
-  if (root->llink != NULL)
-    trecurse(root->llink, free_action);
-  if (root->rlink != NULL)
-    trecurse(root->rlink, free_action);
-
-  (*free_action) ((void *) root->key);
-  free(root);
-}
-
+/*
+ * Free the nodes of a tree without recursion: rotate left subtrees up
+ * until the root has none, then free the root and carry on with its
+ * right subtree.
+ */
 void
 _DEFUN(tdestroy, (vrootp, freefct),
        void *vrootp _AND
        void (*freefct)(void *))
 {
   node_t *root = (node_t *) vrootp;
-
-  if (root != NULL)
-    trecurse(root, freefct);
+  node_t *q;
+
+  while (root != NULL)
+    {
+      if ((q = root->llink) != NULL)
+	{
+	  root->llink = q->rlink;
+	  q->rlink = root;
+	  root = q;
+	}
+      else
+	{
+	  q = root->rlink;
+	  (*freefct) ((void *) root->key);
+	  __tnode_free (root);
+	  root = q;
+	}
+    }
 }
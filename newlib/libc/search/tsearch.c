@@ -2,7 +2,8 @@
 
 /*
  * Tree search generalized from Knuth (6.2.2) Algorithm T just like
- * the AT&T man page says.
+ * the AT&T man page says.  The tree is kept balanced as a red-black
+ * tree, so sorted input does not degrade it into a list.
  *
  * The node_t structure is for internal use only, lint doesn't grok it.
  *
@@ -21,7 +22,105 @@ __RCSID("$NetBSD: tsearch.c,v 1.3 1999/09/16 11:45:37 lukem Exp $");
 #include <assert.h>
 #define _SEARCH_PRIVATE
 #include <search.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <sys/lock.h>
+
+/*
+ * Nodes are carved from slabs of TNODE_SLAB.  Each slab keeps its own
+ * free list, and slabs with a free node are chained so allocation takes
+ * the first.  A node finds its slab from its slot index.  A slab whose
+ * nodes are all free goes back to malloc, except for one kept spare, so
+ * tdelete and tdestroy return memory instead of holding the peak.
+ */
+#define TNODE_SLAB	64
+
+struct tnode_slab {
+	struct tnode_slab *next, *prev;	/* slabs with a free node */
+	node_t *free;
+	unsigned int used;
+	node_t nodes[TNODE_SLAB];
+};
+
+#define TNODE_SLAB_OF(q) \
+	((struct tnode_slab *)((char *)((q) - (q)->slot) \
+			       - offsetof(struct tnode_slab, nodes)))
+
+static struct tnode_slab *tnode_partial;
+static struct tnode_slab *tnode_spare;
+__LOCK_INIT(static, tnode_lock);
+
+node_t *
+_DEFUN_VOID(__tnode_alloc)
+{
+	struct tnode_slab *s;
+	node_t *q;
+	int i;
+
+	__lock_acquire(tnode_lock);
+	if ((s = tnode_partial) == NULL) {
+		if ((s = tnode_spare) != NULL)
+			tnode_spare = NULL;
+		else if ((s = malloc(sizeof(*s))) != NULL) {
+			for (i = 0; i < TNODE_SLAB; i++) {
+				s->nodes[i].slot = i;
+				s->nodes[i].llink = &s->nodes[i + 1];
+			}
+			s->nodes[TNODE_SLAB - 1].llink = NULL;
+			s->free = &s->nodes[0];
+			s->used = 0;
+		} else {
+			__lock_release(tnode_lock);
+			return NULL;
+		}
+		s->prev = NULL;
+		s->next = NULL;
+		tnode_partial = s;
+	}
+	q = s->free;
+	s->free = q->llink;
+	s->used++;
+	if (s->free == NULL) {		/* full: off the partial list */
+		tnode_partial = s->next;
+		if (s->next != NULL)
+			s->next->prev = NULL;
+	}
+	__lock_release(tnode_lock);
+	return q;
+}
+
+void
+_DEFUN(__tnode_free, (q),
+	node_t *q)
+{
+	struct tnode_slab *s = TNODE_SLAB_OF(q);
+
+	__lock_acquire(tnode_lock);
+	if (s->free == NULL) {		/* was full: back on the list */
+		s->prev = NULL;
+		s->next = tnode_partial;
+		if (tnode_partial != NULL)
+			tnode_partial->prev = s;
+		tnode_partial = s;
+	}
+	q->llink = s->free;
+	s->free = q;
+	if (--s->used == 0) {
+		if (s->prev != NULL)
+			s->prev->next = s->next;
+		else
+			tnode_partial = s->next;
+		if (s->next != NULL)
+			s->next->prev = s->prev;
+		if (tnode_spare == NULL) {
+			tnode_spare = s;
+			s = NULL;
+		}
+	} else
+		s = NULL;
+	__lock_release(tnode_lock);
+	free(s);
+}
 
 /* find or insert datum into search tree */
 void *
@@ -30,29 +129,83 @@ _DEFUN(tsearch, (vkey, vrootp, compar),
 	void **vrootp _AND		/* address of tree root */
 	int (*compar)(const void *, const void *))
 {
-	node_t *q;
-	node_t **rootp = (node_t **)vrootp;
+	node_t **path[_TSEARCH_MAXDEPTH + 1];	/* links from the root down */
+	node_t *q, *x, *p, *g, *u;
+	int n = 0;
 
-	if (rootp == NULL)
+	if (vrootp == NULL)
 		return NULL;
 
-	while (*rootp != NULL) {	/* Knuth's T1: */
+	path[0] = (node_t **)vrootp;
+	while (*path[n] != NULL) {	/* Knuth's T1: */
 		int r;
 
-		if ((r = (*compar)(vkey, (*rootp)->key)) == 0)	/* T2: */
-			return *rootp;		/* we found it! */
+		if ((r = (*compar)(vkey, (*path[n])->key)) == 0)	/* T2: */
+			return *path[n];	/* we found it! */
 
-		rootp = (r < 0) ?
-		    &(*rootp)->llink :		/* T3: follow left branch */
-		    &(*rootp)->rlink;		/* T4: follow right branch */
+		path[n + 1] = (r < 0) ?
+		    &(*path[n])->llink :	/* T3: follow left branch */
+		    &(*path[n])->rlink;		/* T4: follow right branch */
+		n++;
 	}
 
-	q = malloc(sizeof(node_t));		/* T5: key not found */
-	if (q != 0) {				/* make new node */
-		*rootp = q;			/* link new node to old */
-		/* LINTED const castaway ok */
-		q->key = (void *)vkey;		/* initialize new node */
-		q->llink = q->rlink = NULL;
+	q = __tnode_alloc();			/* T5: key not found */
+	if (q == NULL)
+		return NULL;
+	*path[n] = q;				/* link new node to old */
+	/* LINTED const castaway ok */
+	q->key = (void *)vkey;			/* initialize new node */
+	q->llink = q->rlink = NULL;
+	q->red = 1;
+
+	/*
+	 * Restore the red-black properties: while the node x at depth n
+	 * and its parent are both red, either recolour and move up two
+	 * levels, or rotate and stop.  The parent of a red node is never
+	 * the root, so the grandparent exists.
+	 */
+	x = q;
+	while (n >= 2 && (p = *path[n - 1])->red) {
+		g = *path[n - 2];
+		if (p == g->llink) {
+			u = g->rlink;
+			if (u != NULL && u->red) {
+				p->red = u->red = 0;
+				g->red = 1;
+				x = g;
+				n -= 2;
+				continue;
+			}
+			if (x == p->rlink) {	/* rotate x above p */
+				p->rlink = x->llink;
+				x->llink = p;
+				g->llink = p = x;
+			}
+			*path[n - 2] = p;	/* rotate p above g */
+			g->llink = p->rlink;
+			p->rlink = g;
+		} else {
+			u = g->llink;
+			if (u != NULL && u->red) {
+				p->red = u->red = 0;
+				g->red = 1;
+				x = g;
+				n -= 2;
+				continue;
+			}
+			if (x == p->llink) {
+				p->llink = x->rlink;
+				x->rlink = p;
+				g->rlink = p = x;
+			}
+			*path[n - 2] = p;
+			g->rlink = p->llink;
+			p->llink = g;
+		}
+		p->red = 0;
+		g->red = 1;
+		break;
 	}
+	(*path[0])->red = 0;
 	return q;
 }
@@ -23,36 +23,48 @@ __RCSID("$NetBSD: twalk.c,v 1.1 1999/02/22 10:33:16 christos Exp $");
 #include <search.h>
 #include <stdlib.h>
 
-static void trecurse(const node_t *,
-    void (*action)(const void *, VISIT, int), int level);
-
-/* Walk the nodes of a tree */
-static void
-trecurse(root, action, level)
-	const node_t *root;	/* Root of the tree to be walked */
-	void (*action)(const void *, VISIT, int);
-	int level;
-{
-
-	if (root->llink == NULL && root->rlink == NULL)
-		(*action)(root, leaf, level);
-	else {
-		(*action)(root, preorder, level);
-		if (root->llink != NULL)
-			trecurse(root->llink, action, level + 1);
-		(*action)(root, postorder, level);
-		if (root->rlink != NULL)
-			trecurse(root->rlink, action, level + 1);
-		(*action)(root, endorder, level);
-	}
-}
-
 /* Walk the nodes of a tree */
 void
 _DEFUN(twalk, (vroot, action),
 	const void *vroot _AND	/* Root of the tree to be walked */
 	void (*action)(const void *, VISIT, int))
 {
-	if (vroot != NULL && action != NULL)
-		trecurse(vroot, action, 0);
+	const node_t *path[_TSEARCH_MAXDEPTH];	/* nodes from the root down */
+	VISIT next[_TSEARCH_MAXDEPTH];		/* next visit of each */
+	const node_t *root;
+	int level = 0;
+
+	if (vroot == NULL || action == NULL)
+		return;
+
+	path[0] = vroot;
+	next[0] = preorder;
+	do {
+		root = path[level];
+		if (root->llink == NULL && root->rlink == NULL) {
+			(*action)(root, leaf, level);
+			level--;
+			continue;
+		}
+		(*action)(root, next[level], level);
+		switch (next[level]) {
+		case preorder:
+			next[level] = postorder;
+			if (root->llink != NULL) {
+				path[++level] = root->llink;
+				next[level] = preorder;
+			}
+			break;
+		case postorder:
+			next[level] = endorder;
+			if (root->rlink != NULL) {
+				path[++level] = root->rlink;
+				next[level] = preorder;
+			}
+			break;
+		default:
+			level--;
+			break;
+		}
+	} while (level >= 0);
 }
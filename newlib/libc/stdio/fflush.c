@@ -231,6 +231,9 @@ _DEFUN(__sflush_r, (ptr, fp),
       p += t;
       n -= t;
     }
+  /* A full buffer went out in one go: try a bigger one next time.  */
+  if (p == fp->_bf._base + fp->_bf._size)
+    __SADPGROW (ptr, fp);
   return 0;
 }
 
@@ -170,6 +170,7 @@ PORTABILITY
 #include <stdlib.h>
 #include <wchar.h>
 #include "local.h"
+#include "../stdlib/local.h"
 
 wint_t
 _DEFUN(__fgetwc, (ptr, fp),
@@ -188,6 +189,13 @@ _DEFUN(__fgetwc, (ptr, fp),
       fp->_r--;
       return (wc);
     }
+  if (*fp->_p < 0x80 && __SMBASCII (fp))
+    {
+      /* Likewise for ASCII in UTF-8. */
+      wc = *fp->_p++;
+      fp->_r--;
+      return (wc);
+    }
   do
     {
       nconv = _mbrtowc_r (ptr, &wc, (char *) fp->_p, fp->_r, &fp->_mbstate);
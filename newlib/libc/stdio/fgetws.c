@@ -120,6 +120,7 @@ PORTABILITY
 #include <string.h>
 #include <wchar.h>
 #include "local.h"
+#include "../stdlib/local.h"
 
 #ifdef __IMPL_UNLOCKED__
 #define _fgetws_r _fgetws_unlocked_r
@@ -136,7 +137,8 @@ _DEFUN(_fgetws_r, (ptr, ws, n, fp),
   wchar_t *wsp;
   size_t nconv;
   const char *src;
-  unsigned char *nl;
+  unsigned char *nl, *p, *end;
+  int ascii;
 
   _newlib_flockfile_start (fp);
   ORIENT (fp, 1);
@@ -151,10 +153,35 @@ _DEFUN(_fgetws_r, (ptr, ws, n, fp),
     /* EOF */
     goto error;
   wsp = ws;
+  ascii = __SMBASCII (fp);
   do
     {
+      if (ascii && fp->_mbstate.__count == 0)
+	{
+	  /* Copy ASCII straight across, up to NL or the first byte that
+	     needs converting. */
+	  p = fp->_p;
+	  end = p + (fp->_r < n - 1 ? fp->_r : n - 1);
+	  while (p < end && *p < 0x80)
+	    if ((*wsp++ = *p++) == L'\n')
+	      break;
+	  nconv = p - fp->_p;
+	  fp->_r -= nconv;
+	  fp->_p = p;
+	  n -= nconv;
+	  if (p == end || (nconv > 0 && wsp[-1] == L'\n'))
+	    continue;
+	}
       src = (char *) fp->_p;
-      nl = memchr (fp->_p, '\n', fp->_r);
+      if (ascii)
+	{
+	  /* Only convert the run of non-ASCII bytes. */
+	  for (nl = fp->_p + 1; nl < fp->_p + fp->_r && *nl >= 0x80; nl++)
+	    ;
+	  nl--;
+	}
+      else
+	nl = memchr (fp->_p, '\n', fp->_r);
       nconv = _mbsnrtowcs_r (ptr, wsp, &src,
 			     /* Read all bytes up to the next NL, or up to the
 				end of the buffer if there is no NL. */
@@ -182,7 +209,7 @@ _DEFUN(_fgetws_r, (ptr, ws, n, fp),
       n -= nconv;
       wsp += nconv;
     }
-  while (wsp[-1] != L'\n' && n > 1 && (fp->_r > 0
+  while ((wsp == ws || wsp[-1] != L'\n') && n > 1 && (fp->_r > 0
 	 || __srefill_r (ptr, fp) == 0));
   if (wsp == ws)
     /* EOF */
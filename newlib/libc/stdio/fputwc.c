@@ -180,7 +180,9 @@ PORTABILITY
 #include <stdio.h>
 #include <stdlib.h>
 #include <wchar.h>
+#include "fvwrite.h"
 #include "local.h"
+#include "../stdlib/local.h"
 
 wint_t
 _DEFUN(__fputwc, (ptr, wc, fp),
@@ -191,7 +193,8 @@ _DEFUN(__fputwc, (ptr, wc, fp),
   char buf[MB_LEN_MAX];
   size_t i, len;
 
-  if (MB_CUR_MAX == 1 && wc > 0 && wc <= UCHAR_MAX)
+  if ((MB_CUR_MAX == 1 && wc > 0 && wc <= UCHAR_MAX)
+      || ((wint_t) wc < 0x80 && __SWCASCII (fp)))
     {
       /*
        * Assume single-byte locale with no special encoding.
@@ -217,6 +220,72 @@ _DEFUN(__fputwc, (ptr, wc, fp),
   return (wint_t) wc;
 }
 
+/*
+ * Write N wide characters from WS, converting them a buffer at a time
+ * with runs of ASCII copied straight across where the charset allows.
+ * Return 0, or EOF on error.
+ */
+int
+_DEFUN(__sputws_r, (ptr, fp, ws, n),
+	struct _reent *ptr _AND
+	FILE *fp _AND
+	const wchar_t *ws _AND
+	size_t n)
+{
+  char buf[BUFSIZ];
+  const wchar_t *end = ws + n;
+  size_t i, len;
+  int sb = MB_CUR_MAX == 1;
+#ifdef _FVWRITE_IN_STREAMIO
+  struct __suio uio;
+  struct __siov iov;
+
+  uio.uio_iov = &iov;
+  uio.uio_iovcnt = 1;
+  iov.iov_base = buf;
+#endif
+
+  while (ws < end)
+    {
+      i = 0;
+      while (ws < end && i <= sizeof (buf) - MB_LEN_MAX)
+	{
+	  if ((wint_t) *ws < 0x80 && __SWCASCII (fp))
+	    {
+	      /* Stays true until the next non-ASCII character. */
+	      do
+		buf[i++] = (char) *ws++;
+	      while (ws < end && (wint_t) *ws < 0x80 && i < sizeof (buf));
+	      continue;
+	    }
+	  if (sb && *ws > 0 && *ws <= UCHAR_MAX)
+	    {
+	      /* Single-byte locale, as in __fputwc. */
+	      buf[i++] = (char) *ws++;
+	      continue;
+	    }
+	  if ((len = _wcrtomb_r (ptr, buf + i, *ws, &fp->_mbstate))
+	      == (size_t) -1)
+	    {
+	      fp->_flags |= __SERR;
+	      return EOF;
+	    }
+	  i += len;
+	  ws++;
+	}
+#ifdef _FVWRITE_IN_STREAMIO
+      iov.iov_len = uio.uio_resid = i;
+      if (__sfvwrite_r (ptr, fp, &uio) != 0)
+	return EOF;
+#else
+      for (len = 0; len < i; len++)
+	if (__sputc_r (ptr, (unsigned char) buf[len], fp) == EOF)
+	  return EOF;
+#endif
+    }
+  return 0;
+}
+
 wint_t
 _DEFUN(_fputwc_r, (ptr, wc, fp),
 	struct _reent *ptr _AND
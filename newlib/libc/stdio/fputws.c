@@ -106,7 +106,6 @@ PORTABILITY
 #include <_ansi.h>
 #include <reent.h>
 #include <errno.h>
-#include <limits.h>
 #include <stdio.h>
 #include <wchar.h>
 #include "fvwrite.h"
@@ -123,62 +122,16 @@ _DEFUN(_fputws_r, (ptr, ws, fp),
 	const wchar_t *ws _AND
 	FILE *fp)
 {
-  size_t nbytes;
-  char buf[BUFSIZ];
-#ifdef _FVWRITE_IN_STREAMIO
-  struct __suio uio;
-  struct __siov iov;
-
   _newlib_flockfile_start (fp);
   ORIENT (fp, 1);
-  if (cantwrite (ptr, fp) != 0)
-    goto error;
-  uio.uio_iov = &iov;
-  uio.uio_iovcnt = 1;
-  iov.iov_base = buf;
-  do
+  if (cantwrite (ptr, fp) != 0
+      || __sputws_r (ptr, fp, ws, wcslen (ws)) != 0)
     {
-      nbytes = _wcsrtombs_r(ptr, buf, &ws, sizeof (buf), &fp->_mbstate);
-      if (nbytes == (size_t) -1)
-	goto error;
-      iov.iov_len = uio.uio_resid = nbytes;
-      if (__sfvwrite_r(ptr, fp, &uio) != 0)
-	goto error;
+      _newlib_flockfile_exit (fp);
+      return (-1);
     }
-  while (ws != NULL);
-  _newlib_flockfile_exit (fp);
-  return (0);
-
-error:
   _newlib_flockfile_end (fp);
-  return (-1);
-#else
-  _newlib_flockfile_start (fp);
-  ORIENT (fp, 1);
-  if (cantwrite (ptr, fp) != 0)
-    goto error;
-
-  do
-    {
-      size_t i = 0;
-      nbytes = _wcsrtombs_r (ptr, buf, &ws, sizeof (buf), &fp->_mbstate);
-      if (nbytes == (size_t) -1)
-	goto error;
-      while (i < nbytes)
-        {
-	  if (__sputc_r (ptr, buf[i], fp) == EOF)
-	    goto error;
-	  i++;
-        }
-    }
-  while (ws != NULL);
-  _newlib_flockfile_exit (fp);
   return (0);
-
-error:
-  _newlib_flockfile_end (fp);
-  return (-1);
-#endif
 }
 
 int
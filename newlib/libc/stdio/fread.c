@@ -116,6 +116,7 @@ Supporting OS subroutines required: <<close>>, <<fstat>>, <<isatty>>,
 #include <stdio.h>
 #include <string.h>
 #include <malloc.h>
+#include <limits.h>
 #include "local.h"
 
 #ifdef __IMPL_UNLOCKED__
@@ -173,6 +174,42 @@ _DEFUN(crlf_r, (ptr, fp, buf, count, eof),
 
 #endif
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+/*
+ * Read up to N bytes straight into BUF by lending it to __srefill_r
+ * in place of the stream buffer.  The stream buffer must be empty.
+ * Store the number of bytes read in *NREAD and return what
+ * __srefill_r returned.
+ */
+static int
+_DEFUN(sread_direct, (ptr, fp, buf, n, nread),
+       struct _reent * ptr _AND
+       FILE * fp _AND
+       char * buf _AND
+       int n _AND
+       size_t * nread)
+{
+  int rc;
+  /* save fp buffering state */
+  void *old_base = fp->_bf._base;
+  void * old_p = fp->_p;
+  int old_size = fp->_bf._size;
+
+  /* allow __refill to use user's buffer */
+  fp->_bf._base = (unsigned char *) buf;
+  fp->_bf._size = n;
+  fp->_p = (unsigned char *) buf;
+  rc = __srefill_r (ptr, fp);
+  /* restore fp buffering back to original state */
+  fp->_bf._base = old_base;
+  fp->_bf._size = old_size;
+  fp->_p = old_p;
+  *nread = fp->_r;
+  fp->_r = 0;
+  return rc;
+}
+#endif /* !PREFER_SIZE_OVER_SPEED && !__OPTIMIZE_SIZE__ */
+
 size_t
 _DEFUN(_fread_r, (ptr, buf, size, count, fp),
        struct _reent * ptr _AND
@@ -184,7 +221,7 @@ _DEFUN(_fread_r, (ptr, buf, size, count, fp),
   register size_t resid;
   register char *p;
   register int r;
-  size_t total;
+  size_t total, n;
 
   if ((resid = count * size) == 0)
     return 0;
@@ -218,23 +255,9 @@ _DEFUN(_fread_r, (ptr, buf, size, count, fp),
       /* Finally read directly into user's buffer if needed.  */
       while (resid > 0)
 	{
-	  int rc = 0;
-	  /* save fp buffering state */
-	  void *old_base = fp->_bf._base;
-	  void * old_p = fp->_p;
-	  int old_size = fp->_bf._size;
-	  /* allow __refill to use user's buffer */
-	  fp->_bf._base = (unsigned char *) p;
-	  fp->_bf._size = resid;
-	  fp->_p = (unsigned char *) p;
-	  rc = __srefill_r (ptr, fp);
-	  /* restore fp buffering back to original state */
-	  fp->_bf._base = old_base;
-	  fp->_bf._size = old_size;
-	  fp->_p = old_p;
-	  resid -= fp->_r;
-	  p += fp->_r;
-	  fp->_r = 0;
+	  int rc = sread_direct (ptr, fp, p, resid, &n);
+	  resid -= n;
+	  p += n;
 	  if (rc)
 	    {
 #ifdef __SCLE
@@ -259,19 +282,42 @@ _DEFUN(_fread_r, (ptr, buf, size, count, fp),
 	  /* fp->_r = 0 ... done in __srefill */
 	  p += r;
 	  resid -= r;
-	  if (__srefill_r (ptr, fp))
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+	  /*
+	   * Once the buffer is drained, read whole buffer-sized blocks
+	   * straight into the caller's memory rather than copying them
+	   * through the buffer.  Not while reading back pushed-back
+	   * characters, whose refill must return the saved buffer.
+	   */
+	  if (resid >= (size_t) fp->_bf._size && fp->_bf._base != NULL
+	      && (fp->_flags & (__SRD | __SSTR)) == __SRD && !HASUB (fp))
 	    {
-	      /* no more input: return partial result */
-#ifdef __SCLE
-	      if (fp->_flags & __SCLE)
-		{
-		  _newlib_flockfile_exit (fp);
-		  return crlf_r (ptr, fp, buf, total-resid, 1) / size;
-		}
+	      int rc;
+
+	      fp->_r = 0;
+	      n = (resid < INT_MAX ? resid : INT_MAX)
+		  / fp->_bf._size * fp->_bf._size;
+	      rc = sread_direct (ptr, fp, p, n, &n);
+	      p += n;
+	      resid -= n;
+	      if (rc == 0)
+		continue;
+	    }
+	  else
 #endif
+	  if (__srefill_r (ptr, fp) == 0)
+	    continue;
+
+	  /* no more input: return partial result */
+#ifdef __SCLE
+	  if (fp->_flags & __SCLE)
+	    {
 	      _newlib_flockfile_exit (fp);
-	      return (total - resid) / size;
+	      return crlf_r (ptr, fp, buf, total-resid, 1) / size;
 	    }
+#endif
+	  _newlib_flockfile_exit (fp);
+	  return (total - resid) / size;
 	}
       _CAST_VOID memcpy ((_PTR) p, (_PTR) fp->_p, resid);
       fp->_r -= resid;
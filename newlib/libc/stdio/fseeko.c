@@ -335,6 +335,7 @@ _DEFUN(_fseeko_r, (ptr, fp, offset, whence),
   fp->_p = fp->_bf._base;
   if (HASUB (fp))
     FREEUB (ptr, fp);
+  __SADPRESET (ptr, fp);
   fp->_flags &= ~__SEOF;
   n = target - curoff;
   if (n)
@@ -366,6 +367,7 @@ dumb:
     FREEUB (ptr, fp);
   fp->_p = fp->_bf._base;
   fp->_r = 0;
+  __SADPRESET (ptr, fp);
   /* fp->_w = 0; *//* unnecessary (I think...) */
   fp->_flags &= ~__SEOF;
   /* Reset no-optimization flag after successful seek.  The
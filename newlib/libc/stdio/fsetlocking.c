@@ -25,15 +25,18 @@
  */
 /*
 FUNCTION
-<<__fsetlocking>>---set or query locking mode on FILE stream
+<<__fsetlocking>>, <<__fsetbuffering>>---set or query locking or buffering mode on FILE stream
 
 INDEX
 	__fsetlocking
+INDEX
+	__fsetbuffering
 
 ANSI_SYNOPSIS
 	#include <stdio.h>
 	#include <stdio_ext.h>
 	int __fsetlocking(FILE *<[fp]>, int <[type]>);
+	int __fsetbuffering(FILE *<[fp]>, int <[type]>);
 
 DESCRIPTION
 This function sets how the stdio functions handle locking of FILE <[fp]>.
@@ -48,11 +51,27 @@ locking themselves.
 
 <<FSETLOCKING_QUERY>> returns the current locking mode without changing it.
 
+<<__fsetbuffering>> sets how the size of the buffer of <[fp]> is chosen:
+
+<<FSETBUFFERING_FIXED>> is the default state, where the buffer size is
+chosen once, when the buffer is first needed.
+
+<<FSETBUFFERING_ADAPTIVE>> lets the buffer of a fully buffered stream grow
+while it is used for sequential transfers: each time the whole buffer is
+filled by one read or emptied by one write, it is doubled, up to 64 KiB.
+Seeking puts it back to its initial size.  Buffers given with <<setvbuf>>
+are never resized.
+
+<<FSETBUFFERING_QUERY>> returns the current buffering mode without
+changing it.
+
 RETURNS
 <<__fsetlocking>> returns the current locking mode of <[fp]>.
+<<__fsetbuffering>> returns the previous buffering mode of <[fp]>.
 
 PORTABILITY
-This function originates from Solaris and is also provided by GNU libc.
+<<__fsetlocking>> originates from Solaris and is also provided by GNU libc.
+<<__fsetbuffering>> is a newlib extension.
 
 No supporting OS subroutines are required.
 */
@@ -87,4 +106,30 @@ _DEFUN(__fsetlocking, (fp, type),
   return result;
 }
 
+int
+_DEFUN(__fsetbuffering, (fp, type),
+       FILE * fp _AND
+       int type)
+{
+  int result;
+  CHECK_INIT(_REENT, fp);
+  _newlib_flockfile_start (fp);
+  result = (fp->_flags2 & __SADP) ? FSETBUFFERING_ADAPTIVE
+				  : FSETBUFFERING_FIXED;
+  switch (type)
+    {
+    case FSETBUFFERING_ADAPTIVE:
+      fp->_flags2 |= __SADP;
+      break;
+    case FSETBUFFERING_FIXED:
+      fp->_flags2 &= ~__SADP;
+      break;
+    case FSETBUFFERING_QUERY:
+    default:
+      break;
+    }
+  _newlib_flockfile_end (fp);
+  return result;
+}
+
 #endif /* __rtems__ */
@@ -22,6 +22,9 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <limits.h>
+#ifdef HAVE_WRITEV
+#include <sys/uio.h>
+#endif
 #include "local.h"
 #include "fvwrite.h"
 
@@ -37,6 +40,68 @@
       iov++; \
     }
 
+#ifdef HAVE_WRITEV
+/* Set once writev has failed with ENOSYS.  */
+static int no_writev;
+
+/*
+ * Write the buffered data of FP and the first LEN bytes at P with
+ * a single writev, instead of filling the buffer from P and flushing
+ * it first.  Return the number of bytes of P written, or -1 on error.
+ * Without a working writev, just flush the buffer and return 0, so
+ * that the caller writes P through fp->_write.
+ */
+static int
+_DEFUN(__swritev, (ptr, fp, p, len),
+       struct _reent *ptr _AND
+       register FILE *fp _AND
+       _CONST char *p _AND
+       int len)
+{
+  struct iovec iov[2];
+  int n = fp->_p - fp->_bf._base;
+  int serrno, e;
+  ssize_t w;
+
+  if (no_writev)
+    return _fflush_r (ptr, fp) ? -1 : 0;
+  iov[0].iov_base = fp->_bf._base;
+  iov[0].iov_len = n;
+  iov[1].iov_base = (_PTR) p;
+  iov[1].iov_len = len;
+  fp->_flags &= ~__SOFF;
+  serrno = errno;
+  w = writev (fp->_file, iov, 2);
+  if (w < 0)
+    {
+      /* writev sets the global errno; report it through PTR.  */
+      e = errno;
+      errno = serrno;
+      if (e == ENOSYS)
+	{
+	  no_writev = 1;
+	  return _fflush_r (ptr, fp) ? -1 : 0;
+	}
+      ptr->_errno = e;
+      return -1;
+    }
+  if (w == 0)
+    return -1;
+  if (w < n)
+    {
+      /* Part of the buffer went out; keep the rest.  */
+      _CAST_VOID memmove ((_PTR) fp->_bf._base,
+			  (_PTR) (fp->_bf._base + w), n - w);
+      fp->_p -= w;
+      fp->_w += w;
+      return 0;
+    }
+  fp->_p = fp->_bf._base;
+  fp->_w = fp->_bf._size;
+  return w - n;
+}
+#endif /* HAVE_WRITEV */
+
 /*
  * Write some memory regions.  Return zero on success, EOF on error.
  *
@@ -180,6 +245,27 @@ _DEFUN(__sfvwrite_r, (ptr, fp, uio),
 	      fp->_p += w;
 	      w = len;		/* but pretend copied all */
 	    }
+#ifdef HAVE_WRITEV
+	  else if (fp->_p > fp->_bf._base && len >= fp->_bf._size
+		   && fp->_p - fp->_bf._base < INT_MAX - fp->_bf._size
+		   && (fp->_write == __swrite
+#ifdef __LARGE64_FILES
+		       || fp->_write == __swrite64
+#endif
+		      )
+		   && (fp->_flags & __SAPP) == 0)
+	    {
+	      /*
+	       * Plain file with a partial buffer and a large write:
+	       * send both together, whole buffer-sized blocks of the
+	       * data only.  Whatever is left goes through the buffer.
+	       */
+	      w = (int)MIN (len, INT_MAX - (fp->_p - fp->_bf._base));
+	      w = __swritev (ptr, fp, p, w / fp->_bf._size * fp->_bf._size);
+	      if (w < 0)
+		goto err;
+	    }
+#endif
 	  else if (fp->_p > fp->_bf._base || len < fp->_bf._size)
 	    {
 	      /* pass through the buffer */
@@ -41,6 +41,7 @@ No supporting OS subroutines are directly required.
 #include <_ansi.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include "local.h"
 
@@ -54,12 +55,12 @@ _DEFUN(__getdelim, (bufptr, n, delim, fp),
        int delim     _AND 
        FILE *fp)
 {
+  struct _reent *reent = _REENT;
   char *buf;
   char *ptr;
-  size_t newsize, numbytes;
-  int pos;
-  int ch;
-  int cont;
+  size_t newsize, pos, len;
+  unsigned char *p, *t;
+  unsigned char c;
 
   if (fp == NULL || bufptr == NULL || n == NULL)
     {
@@ -79,54 +80,77 @@ _DEFUN(__getdelim, (bufptr, n, delim, fp),
       *n = DEFAULT_LINE_SIZE;
     }
 
-  CHECK_INIT (_REENT, fp);
+  CHECK_INIT (reent, fp);
 
   _newlib_flockfile_start (fp);
 
-  numbytes = *n;
   ptr = buf;
 
-  cont = 1;
-
-  while (cont)
+  for (;;)
     {
-      /* fill buffer - leaving room for nul-terminator */
-      while (--numbytes > 0)
-        {
-          if ((ch = getc_unlocked (fp)) == EOF)
-            {
-	      cont = 0;
-              break;
-            }
-	  else 
-            {
-              *ptr++ = ch;
-              if (ch == delim)
-                {
-                  cont = 0;
-                  break;
-                }
-            }
-        }
-
-      if (cont)
-        {
-          /* Buffer is too small so reallocate a larger buffer.  */
-          pos = ptr - buf;
-          newsize = (*n << 1);
-          buf = realloc (buf, newsize);
-          if (buf == NULL)
-            {
-              cont = 0;
-              break;
-            }
-
-          /* After reallocating, continue in new buffer */          
-          *bufptr = buf;
-          *n = newsize;
-          ptr = buf + pos;
-          numbytes = newsize - pos;
-        }
+#ifdef __SCLE
+      if (fp->_flags & __SCLE)
+	{
+	  /* Line endings are converted a byte at a time.  */
+	  int ch = __sgetc_r (reent, fp);
+
+	  if (ch == EOF)
+	    break;
+	  c = ch;
+	  p = &c;
+	  len = 1;
+	}
+      else
+#endif
+	{
+	  /* If the stream buffer is empty, refill it.  */
+	  if (fp->_r <= 0 && __srefill_r (reent, fp))
+	    break;
+	  p = fp->_p;
+	  len = fp->_r;
+	}
+
+      /*
+       * Take everything up to and including the delimiter, or the
+       * whole chunk if it isn't there.
+       */
+      t = NULL;
+      if (delim == (unsigned char) delim
+	  && (t = (unsigned char *) memchr (p, delim, len)) != NULL)
+	len = ++t - p;
+
+      /* Grow the line buffer, leaving room for the nul-terminator.  */
+      pos = ptr - buf;
+      if (pos + len >= *n)
+	{
+	  newsize = *n;
+	  while (pos + len >= newsize)
+	    newsize <<= 1;
+	  buf = realloc (buf, newsize);
+	  if (buf == NULL)
+	    {
+	      /* Keep what fits in the old buffer.  */
+	      buf = *bufptr;
+	      len = *n - 1 - pos;
+	      t = p + len;
+	    }
+	  else
+	    {
+	      *bufptr = buf;
+	      *n = newsize;
+	      ptr = buf + pos;
+	    }
+	}
+
+      memcpy (ptr, p, len);
+      ptr += len;
+      if (p != &c)
+	{
+	  fp->_r -= len;
+	  fp->_p += len;
+	}
+      if (t != NULL)
+	break;
     }
 
   _newlib_flockfile_end (fp);
@@ -139,4 +163,3 @@ _DEFUN(__getdelim, (bufptr, n, delim, fp),
   *ptr = '\0';
   return (ssize_t)(ptr - buf);
 }
-
@@ -142,6 +142,8 @@
 
 extern wint_t _EXFUN(__fgetwc, (struct _reent *, FILE *));
 extern wint_t _EXFUN(__fputwc, (struct _reent *, wchar_t, FILE *));
+extern int    _EXFUN(__sputws_r, (struct _reent *, FILE *, const wchar_t *,
+				  size_t));
 extern u_char *_EXFUN(__sccl, (char *, u_char *fmt));
 extern int    _EXFUN(__svfscanf_r,(struct _reent *,FILE *, _CONST char *,va_list));
 extern int    _EXFUN(__ssvfscanf_r,(struct _reent *,FILE *, _CONST char *,va_list));
@@ -183,6 +185,7 @@ extern _VOID   _EXFUN(__sinit,(struct _reent *));
 extern _VOID   _EXFUN(_cleanup_r,(struct _reent *));
 extern _VOID   _EXFUN(__smakebuf_r,(struct _reent *, FILE *));
 extern int    _EXFUN(__swhatbuf_r,(struct _reent *, FILE *, size_t *, int *));
+extern _VOID   _EXFUN(__sresizebuf_r,(struct _reent *, FILE *, size_t));
 extern int    _EXFUN(_fwalk,(struct _reent *, int (*)(FILE *)));
 extern int    _EXFUN(_fwalk_reent,(struct _reent *, int (*)(struct _reent *, FILE *)));
 struct _glue * _EXFUN(__sfmoreglue,(struct _reent *,int n));
@@ -242,6 +245,34 @@ extern _READ_WRITE_RETURN_TYPE _EXFUN(__swrite64,(struct _reent *, void *,
 /* Test whether the given stdio file has an active ungetc buffer;
    release such a buffer, without restoring ordinary unread data.  */
 
+/* Largest buffer an adaptive stream (__SADP) grows to, and the size
+   it goes back to.  */
+#ifndef _ADAPTIVE_BUFSIZ_MAX
+#define	_ADAPTIVE_BUFSIZ_MAX	(64 * 1024)
+#endif
+#ifdef HAVE_BLKSIZE
+#define	__SADPMIN(fp)	((fp)->_blksize > 0 ? (size_t) (fp)->_blksize : BUFSIZ)
+#else
+#define	__SADPMIN(fp)	((size_t) BUFSIZ)
+#endif
+
+/* An adaptive stream whose buffer was filled by the last transfer
+   doubles it before the next one.  The buffer must be empty.  */
+#define	__SADPGROW(ptr, fp) \
+  do { \
+    if (((fp)->_flags2 & __SADP) \
+	&& (fp)->_bf._size < _ADAPTIVE_BUFSIZ_MAX) \
+      __sresizebuf_r (ptr, fp, (fp)->_bf._size * 2 < _ADAPTIVE_BUFSIZ_MAX \
+			       ? (fp)->_bf._size * 2 : _ADAPTIVE_BUFSIZ_MAX); \
+  } while (0)
+
+/* Seeking an adaptive stream drops it back to the initial size.  */
+#define	__SADPRESET(ptr, fp) \
+  do { \
+    if ((fp)->_flags2 & __SADP) \
+      __sresizebuf_r (ptr, fp, __SADPMIN (fp)); \
+  } while (0)
+
 #define	HASUB(fp) ((fp)->_ub._base != NULL)
 #define	FREEUB(ptr, fp) {                    \
 	if ((fp)->_ub._base != (fp)->_ubuf) \
@@ -277,6 +308,23 @@ extern _READ_WRITE_RETURN_TYPE _EXFUN(__swrite64,(struct _reent *, void *,
 #define ORIENT(fp,ori)
 #endif
 
+/*
+ * True if bytes below 0x80 of the stream's charset are just the ASCII
+ * characters and need no conversion, which holds for ASCII and UTF-8
+ * in the initial conversion state.  Needs "../stdlib/local.h".
+ */
+#ifdef _MB_CAPABLE
+#define __SMBASCII(fp) \
+  ((fp)->_mbstate.__count == 0 \
+   && (__MBTOWC == __utf8_mbtowc || __MBTOWC == __ascii_mbtowc))
+#define __SWCASCII(fp) \
+  ((fp)->_mbstate.__count == 0 \
+   && (__WCTOMB == __utf8_wctomb || __WCTOMB == __ascii_wctomb))
+#else
+#define __SMBASCII(fp) 1
+#define __SWCASCII(fp) 1
+#endif
+
 /* WARNING: _dcvt is defined in the stdlib directory, not here!  */
 
 char *_EXFUN(_dcvt,(struct _reent *, char *, double, int, int, char, int));
@@ -72,6 +72,31 @@ _DEFUN(__smakebuf_r, (ptr, fp),
     }
 }
 
+/*
+ * Replace the (empty) malloc'ed buffer of a fully buffered stream by
+ * one of SIZE bytes.  Used for adaptive buffering; if memory is short
+ * the stream just keeps the buffer it has.
+ */
+_VOID
+_DEFUN(__sresizebuf_r, (ptr, fp, size),
+       struct _reent *ptr _AND
+       register FILE *fp _AND
+       size_t size)
+{
+  _PTR p;
+
+  if ((fp->_flags & (__SMBF | __SLBF | __SNBF | __SSTR)) != __SMBF
+      || size == (size_t) fp->_bf._size)
+    return;
+  if ((p = _malloc_r (ptr, size)) == NULL)
+    return;
+  _free_r (ptr, fp->_bf._base);
+  fp->_bf._base = fp->_p = (unsigned char *) p;
+  fp->_bf._size = size;
+  if (fp->_flags & __SWR)
+    fp->_w = size;
+}
+
 /*
  * Internal routine to determine `proper' buffering for a file.
  */
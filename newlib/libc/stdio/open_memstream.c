@@ -67,6 +67,7 @@ Supporting OS subroutines required: <<sbrk>>.
 #include <string.h>
 #include <sys/lock.h>
 #include <stdint.h>
+#include <limits.h>
 #include "local.h"
 
 #ifndef __LARGE64_FILES
@@ -88,8 +89,35 @@ typedef struct memstream {
     wchar_t w;
   } saved; /* saved character that lived at *psize before NUL */
   int8_t wide; /* wide-oriented (>0) or byte-oriented (<0) */
+  FILE *fp; /* the stream, whose buffer is our free space */
 } memstream;
 
+/* Make the free space at the current position the stream's buffer,
+   less room for the trailing NUL and what it saves, so that stdio
+   writes straight into the storage and memwriter has nothing left to
+   copy.  With no free space, leave the stream without a buffer; stdio
+   then makes its own and memwriter copies from it.  */
+static void
+_DEFUN(memsetbuf, (c),
+       memstream *c)
+{
+  FILE *fp = c->fp;
+  size_t nul = c->wide > 0 ? sizeof (wchar_t) : 1;
+  size_t room = c->pos + nul < c->max ? c->max - c->pos - nul : 0;
+
+  if (room > INT_MAX)
+    room = INT_MAX;
+  fp->_bf._base = fp->_p = room ? (unsigned char *) *c->pbuf + c->pos : NULL;
+  fp->_bf._size = fp->_w = room;
+}
+
+/* True if the stream is still writing straight into our storage.  Past
+   the end of the storage, after a seek beyond it, a buffer malloc'd by
+   stdio could sit at the same address.  */
+#define MEMDIRECT(c) ((c)->pos < (c)->max \
+		      && (c)->fp->_bf._base \
+			 == (unsigned char *) *(c)->pbuf + (c)->pos)
+
 /* Write up to non-zero N bytes of BUF into the stream described by COOKIE,
    returning the number of bytes written or EOF on failure.  */
 static _READ_WRITE_RETURN_TYPE
@@ -101,6 +129,10 @@ _DEFUN(memwriter, (ptr, cookie, buf, n),
 {
   memstream *c = (memstream *) cookie;
   char *cbuf = *c->pbuf;
+  size_t nul = c->wide > 0 ? sizeof (wchar_t) : 1;
+  int direct = MEMDIRECT (c);
+  int inplace = direct && buf == cbuf + c->pos;
+  size_t i;
 
   /* size_t is unsigned, but off_t is signed.  Don't let stream get so
      big that user cannot do ftello.  */
@@ -109,27 +141,38 @@ _DEFUN(memwriter, (ptr, cookie, buf, n),
       ptr->_errno = EFBIG;
       return EOF;
     }
-  /* Grow the buffer, if necessary.  Choose a geometric growth factor
-     to avoid quadratic realloc behavior, but use a rate less than
-     (1+sqrt(5))/2 to accomodate malloc overhead.  Overallocate, so
-     that we can add a trailing \0 without reallocating.  The new
-     allocation should thus be max(prev_size*1.5, c->pos+n+1). */
-  if (c->pos + n >= c->max)
+  /* Grow the buffer when the data and the trailing NUL, which saves a
+     whole wchar_t from under it on a wide stream, would fill it.
+     Doubling keeps the total copied by realloc below the final size.
+     When writing in place, a failure only costs the free space for
+     the next buffer, unless the data itself did not fit.  */
+  if (c->pos + n + nul >= c->max)
     {
-      size_t newsize = c->max * 3 / 2;
-      if (newsize < c->pos + n + 1)
-	newsize = c->pos + n + 1;
-      cbuf = _realloc_r (ptr, cbuf, newsize);
-      if (! cbuf)
+      size_t newsize = c->max * 2;
+      if (newsize < c->pos + n + nul + 1)
+	newsize = c->pos + n + nul + 1;
+      cbuf = _realloc_r (ptr, *c->pbuf, newsize);
+      if (cbuf)
+	{
+	  *c->pbuf = cbuf;
+	  c->max = newsize;
+	}
+      else if (c->pos + n + nul > c->max)
 	return EOF; /* errno already set to ENOMEM */
-      *c->pbuf = cbuf;
-      c->max = newsize;
+      else
+	cbuf = *c->pbuf;
     }
   /* If we have previously done a seek beyond eof, ensure all
      intermediate bytes are NUL.  */
   if (c->pos > c->eof)
     memset (cbuf + c->eof, '\0', c->pos - c->eof);
-  memcpy (cbuf + c->pos, buf, n);
+  /* A seek on a wide stream NULs out a whole wchar_t; put back what
+     the data does not cover, or the next save would keep the NULs.  */
+  else if (c->wide > 0 && c->pos < c->eof)
+    for (i = n; i < sizeof (wchar_t); i++)
+      cbuf[c->pos + i] = ((char *) &c->saved.w)[i];
+  if (!inplace)
+    memcpy (cbuf + c->pos, buf, n);
   c->pos += n;
   /* If the user has previously written further, remember what the
      trailing NUL is overwriting.  Otherwise, extend the stream.  */
@@ -141,6 +184,8 @@ _DEFUN(memwriter, (ptr, cookie, buf, n),
     c->saved.c = cbuf[c->pos];
   cbuf[c->pos] = '\0';
   *c->psize = (c->wide > 0) ? c->pos / sizeof (wchar_t) : c->pos;
+  if (direct)
+    memsetbuf (c);
   return n;
 }
 
@@ -177,8 +222,12 @@ _DEFUN(memseeker, (ptr, cookie, pos, whence),
       offset = -1;
     }
 #endif /* __LARGE64_FILES */
-  else
+  /* ftell asks where we are without flushing; moving nothing keeps
+     the data it has yet to flush into our storage where it is.  */
+  else if ((size_t) offset != c->pos)
     {
+      int direct = MEMDIRECT (c);
+
       if (c->pos < c->eof)
 	{
 	  if (c->wide > 0)
@@ -207,6 +256,8 @@ _DEFUN(memseeker, (ptr, cookie, pos, whence),
 	*c->psize = c->eof / sizeof (wchar_t);
       else
 	*c->psize = c->eof;
+      if (direct)
+	memsetbuf (c);
     }
   return (_fpos_t) offset;
 }
@@ -238,8 +289,12 @@ _DEFUN(memseeker64, (ptr, cookie, pos, whence),
       ptr->_errno = ENOSPC;
       offset = -1;
     }
-  else
+  /* ftell asks where we are without flushing; moving nothing keeps
+     the data it has yet to flush into our storage where it is.  */
+  else if ((size_t) offset != c->pos)
     {
+      int direct = MEMDIRECT (c);
+
       if (c->pos < c->eof)
 	{
 	  if (c->wide > 0)
@@ -268,6 +323,8 @@ _DEFUN(memseeker64, (ptr, cookie, pos, whence),
 	*c->psize = c->eof / sizeof (wchar_t);
       else
 	*c->psize = c->eof;
+      if (direct)
+	memsetbuf (c);
     }
   return (_fpos64_t) offset;
 }
@@ -359,6 +416,7 @@ _DEFUN(internal_open_memstream_r, (ptr, buf, size, wide),
   c->eof = 0;
   c->saved.w = L'\0';
   c->wide = (int8_t) wide;
+  c->fp = fp;
 
   _newlib_flockfile_start (fp);
   fp->_file = -1;
@@ -372,6 +430,7 @@ _DEFUN(internal_open_memstream_r, (ptr, buf, size, wide),
   fp->_flags |= __SL64;
 #endif
   fp->_close = memcloser;
+  memsetbuf (c);
   ORIENT (fp, wide);
   _newlib_flockfile_end (fp);
   return fp;
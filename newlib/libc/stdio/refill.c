@@ -115,6 +115,10 @@ _DEFUN(__srefill_r, (ptr, fp),
 	__sflush_r (ptr, fp);
     }
 
+  /* The last read filled the buffer and all of it was used.  */
+  if (fp->_p == fp->_bf._base + fp->_bf._size)
+    __SADPGROW (ptr, fp);
+
   fp->_p = fp->_bf._base;
   fp->_r = fp->_read (ptr, fp->_cookie, (char *) fp->_p, fp->_bf._size);
 #ifndef __CYGWIN__
@@ -379,13 +379,9 @@ _DEFUN(__sfputs_r, (ptr, fp, buf, len),
 
 #ifdef _WIDE_ORIENT
 	if (fp->_flags2 & __SWID) {
-		wchar_t *p;
-
-		p = (wchar_t *) buf;
-		for (i = 0; i < (len / sizeof (wchar_t)); i++) {
-			if (_fputwc_r (ptr, p[i], fp) == WEOF)
-				return -1;
-		}
+		if (__sputws_r (ptr, fp, (_CONST wchar_t *) buf,
+				len / sizeof (wchar_t)) == EOF)
+			return -1;
 	} else {
 #else
 	{
@@ -417,19 +413,16 @@ _DEFUN(__sprint_r, (ptr, fp, uio),
 #ifdef _WIDE_ORIENT
 	if (fp->_flags2 & __SWID) {
 		struct __siov *iov;
-		wchar_t *p;
-		int i, len;
+		int len;
 
 		iov = uio->uio_iov;
 		for (; uio->uio_resid != 0;
 		     uio->uio_resid -= len * sizeof (wchar_t), iov++) {
-			p = (wchar_t *) iov->iov_base;
 			len = iov->iov_len / sizeof (wchar_t);
-			for (i = 0; i < len; i++) {
-				if (_fputwc_r (ptr, p[i], fp) == WEOF) {
-					err = -1;
-					goto out;
-				}
+			if (__sputws_r (ptr, fp, (_CONST wchar_t *) iov->iov_base,
+					len) == EOF) {
+				err = -1;
+				goto out;
 			}
 		}
 	} else
@@ -644,6 +637,43 @@ _EXFUN(get_arg, (struct _reent *data, int n, char *fmt,
 # define GROUPING	0x400		/* use grouping ("'" flag) */
 #endif
 
+/*
+ * A format registered with printf_compile, split into conversions.
+ * Each conversion is preceded by LIT bytes of literal text and spans
+ * LEN bytes after its `%'; the last entry has CONV '\0' and gives only
+ * the trailing text.  Formats using `*', `$' or `'' are not compiled,
+ * so the arguments are always fetched in order.
+ */
+struct __pf_spec {
+	int lit;		/* literal bytes before the `%' */
+	int len;		/* bytes after the `%' */
+	int flags;
+	int width;
+	int prec;
+	char sign;
+	char conv;		/* conversion character */
+};
+
+struct __pf_format {
+	_CONST char *fmt;	/* registered format string */
+#ifdef _MB_CAPABLE
+	mbtowc_p mbtowc;	/* charset the literals were scanned in */
+#endif
+	int has_float;		/* uses a floating point conversion */
+	struct __pf_spec spec[1];
+};
+
+/* Only printf_compile brings in the cache; other versions refer to
+   it weakly.  */
+#if defined (STRING_ONLY) && defined (INTEGER_ONLY)
+_CONST struct __pf_format *_EXFUN(__pf_lookup, (_CONST char *));
+# define PF_LOOKUP(fmt)	__pf_lookup (fmt)
+#else
+_CONST struct __pf_format *_EXFUN(__pf_lookup, (_CONST char *))
+	_ATTRIBUTE ((__weak__));
+# define PF_LOOKUP(fmt)	(__pf_lookup != NULL ? __pf_lookup (fmt) : NULL)
+#endif
+
 int _EXFUN(_VFPRINTF_R, (struct _reent *, FILE *, _CONST char *, va_list));
 
 #ifndef STRING_ONLY
@@ -727,8 +757,14 @@ _DEFUN(_VFPRINTF_R, (data, fp, fmt0, ap),
 #ifdef _MB_CAPABLE
 	wchar_t wc;
 	mbstate_t state;        /* mbtowc calls from library must not change state */
+	/* Look up the locale once per call, not once per format byte. */
+	struct __locale_t *locale = __get_current_locale ();
+	mbtowc_p l_mbtowc = locale->mbtowc;
+	int mb_cur_max = __locale_mb_cur_max_l (locale);
 #endif
 	char *malloc_buf = NULL;/* handy pointer for malloced buffers */
+	_CONST struct __pf_format *pf = NULL;
+	_CONST struct __pf_spec *pfs = NULL; /* next compiled conversion */
 
 	/*
 	 * Choose PADSIZE to trade efficiency vs. size.  If larger printf
@@ -807,10 +843,13 @@ _DEFUN(_VFPRINTF_R, (data, fp, fmt0, ap),
 #define FLUSH()
 #endif
 
-	/* Macros to support positional arguments */
+	/* Macros to support positional arguments.  Compiled formats
+	   have none, so their arguments come straight from AP.  */
 #ifndef _NO_POS_ARGS
 # define GET_ARG(n, ap, type)						\
-	(is_pos_arg							\
+	(pfs != NULL							\
+	 ? va_arg (ap, type)						\
+	 : is_pos_arg							\
 	 ? (n < numargs							\
 	    ? args[n].val_##type					\
 	    : get_arg (data, n, fmt_anchor, &ap, &numargs, args,	\
@@ -904,13 +943,49 @@ _DEFUN(_VFPRINTF_R, (data, fp, fmt0, ap),
 	is_pos_arg = 0;
 #endif
 
+	if ((pf = PF_LOOKUP (fmt0)) != NULL
+#ifdef _MB_CAPABLE
+	    && pf->mbtowc == l_mbtowc
+#endif
+#ifndef FLOATING_POINT
+	    && !pf->has_float
+#endif
+	   )
+		pfs = pf->spec;
+
 	/*
 	 * Scan the format for conversions (`%' character).
 	 */
 	for (;;) {
 	        cp = fmt;
+		if (pfs != NULL) {
+			/* Compiled: the literal and conversion are known. */
+			if ((m = pfs->lit) != 0) {
+				PRINT (cp, m);
+				ret += m;
+				fmt += m;
+			}
+			if (pfs->conv == '\0')
+				goto done;
+			fmt_anchor = fmt;
+			fmt += 1 + pfs->len;
+			flags = pfs->flags;
+			dprec = 0;
+			width = pfs->width;
+			prec = pfs->prec;
+			sign = pfs->sign;
+#ifdef FLOATING_POINT
+			lead = 0;
+#ifdef _WANT_IO_C99_FORMATS
+			nseps = nrepeats = 0;
+#endif
+#endif
+			ch = pfs->conv;
+			pfs++;
+			goto reswitch;
+		}
 #ifdef _MB_CAPABLE
-	        while ((n = __MBTOWC (data, &wc, fmt, MB_CUR_MAX,
+	        while ((n = l_mbtowc (data, &wc, fmt, mb_cur_max,
 				      &state)) != 0) {
 		    if (n < 0) {
 			/* Wave invalid chars through. */
@@ -1792,6 +1867,329 @@ error:
 	/* NOTREACHED */
 }
 
+/* The format cache is shared between all versions of vfprintf.  It is
+   defined once, in the STRING_ONLY/INTEGER_ONLY version.  */
+#if defined (STRING_ONLY) && defined (INTEGER_ONLY)
+
+/* Registered formats, hashed by address with linear probing.  The
+   table is replaced by one twice the size before it gets more than
+   half full, so probes stay short and always reach an empty slot.
+   Entries are never removed and replaced tables are never freed, so
+   lookups need no lock.  */
+#define PF_CACHE_BITS	6	/* initial size, log 2 */
+#define PF_HASH(p, bits)	((unsigned int) (((uintptr_t) (p) >> 3) \
+				 * 2654435761U) >> (32 - (bits)))
+
+struct pf_table {
+	unsigned int bits;		/* 1 << bits slots */
+	unsigned int count;		/* slots in use */
+	struct __pf_format *slot[1];
+};
+
+static struct pf_table *pf_cache;
+__LOCK_INIT(static, pf_cache_lock);
+
+_CONST struct __pf_format *
+_DEFUN(__pf_lookup, (fmt),
+       _CONST char *fmt)
+{
+	_CONST struct pf_table *t = pf_cache;
+	_CONST struct __pf_format *pf;
+	unsigned int i, mask;
+
+	if (t == NULL)
+		return NULL;
+	mask = (1U << t->bits) - 1;
+	for (i = PF_HASH (fmt, t->bits); ; i = (i + 1) & mask) {
+		pf = t->slot[i];
+		if (pf == NULL || pf->fmt == fmt)
+			return pf;
+	}
+}
+
+/* Put PF into the first free slot for it in T.  */
+static void
+_DEFUN(pf_insert, (t, pf),
+       struct pf_table *t	_AND
+       struct __pf_format *pf)
+{
+	unsigned int i, mask = (1U << t->bits) - 1;
+
+	for (i = PF_HASH (pf->fmt, t->bits); t->slot[i] != NULL;
+	     i = (i + 1) & mask)
+		continue;
+	t->slot[i] = pf;
+	t->count++;
+}
+
+/* Return a table of 1 << BITS slots holding the entries of OLD, or
+   NULL if out of memory.  */
+static struct pf_table *
+_DEFUN(pf_rehash, (data, old, bits),
+       struct _reent *data	_AND
+       _CONST struct pf_table *old	_AND
+       unsigned int bits)
+{
+	struct pf_table *t;
+	unsigned int i;
+
+	t = (struct pf_table *) _calloc_r (data, 1, sizeof *t
+				+ ((1U << bits) - 1) * sizeof t->slot[0]);
+	if (t == NULL)
+		return NULL;
+	t->bits = bits;
+	if (old != NULL)
+		for (i = 0; i < 1U << old->bits; i++)
+			if (old->slot[i] != NULL)
+				pf_insert (t, old->slot[i]);
+	return t;
+}
+
+/* Split FMT into literal runs and conversions, as _VFPRINTF_R would
+   parse it, into SPEC if not NULL.  Return the number of entries, or
+   -1 if FMT uses a feature that needs the full parser.  */
+static int
+_DEFUN(pf_compile, (data, fmt0, spec, has_float),
+       struct _reent *data	_AND
+       _CONST char *fmt0	_AND
+       struct __pf_spec *spec	_AND
+       int *has_float)
+{
+	_CONST char *fmt = fmt0;
+	_CONST char *cp;
+	int ch, n, count = 0;
+	int flags, width, prec;
+	char sign;
+#ifdef _MB_CAPABLE
+	wchar_t wc;
+	mbstate_t state;
+	struct __locale_t *locale = __get_current_locale ();
+	int mb_cur_max = __locale_mb_cur_max_l (locale);
+
+	memset (&state, '\0', sizeof (state));
+#endif
+
+	*has_float = 0;
+	for (;;) {
+		cp = fmt;
+#ifdef _MB_CAPABLE
+		while ((n = locale->mbtowc (data, &wc, fmt, mb_cur_max,
+					    &state)) != 0) {
+			if (n < 0) {
+				memset (&state, 0, sizeof state);
+				n = 1;
+			}
+			else if (wc == '%')
+				break;
+			fmt += n;
+		}
+#else
+		while (*fmt != '\0' && *fmt != '%')
+			fmt += 1;
+#endif
+		if (spec != NULL) {
+			spec[count].lit = fmt - cp;
+			spec[count].conv = '\0';
+		}
+		if (*fmt == '\0')
+			return count + 1;
+		cp = ++fmt;
+
+		flags = 0;
+		width = 0;
+		prec = -1;
+		sign = '\0';
+
+rflag:		ch = *fmt++;
+reswitch:	switch (ch) {
+		case ' ':
+			if (!sign)
+				sign = ' ';
+			goto rflag;
+		case '#':
+			flags |= ALT;
+			goto rflag;
+		case '-':
+			flags |= LADJUST;
+			goto rflag;
+		case '+':
+			sign = '+';
+			goto rflag;
+		case '.':
+			n = 0;
+			ch = *fmt++;
+			if (ch == '*')
+				return -1;
+			while (is_digit (ch)) {
+				n = 10 * n + to_digit (ch);
+				ch = *fmt++;
+			}
+			prec = n < 0 ? -1 : n;
+			goto reswitch;
+		case '0':
+			flags |= ZEROPAD;
+			goto rflag;
+		case '1': case '2': case '3': case '4':
+		case '5': case '6': case '7': case '8': case '9':
+			n = 0;
+			do {
+				n = 10 * n + to_digit (ch);
+				ch = *fmt++;
+			} while (is_digit (ch));
+			if (ch == '$')
+				return -1;
+			width = n;
+			goto reswitch;
+		case 'L':
+			flags |= LONGDBL;
+			goto rflag;
+		case 'h':
+#ifdef _WANT_IO_C99_FORMATS
+			if (*fmt == 'h') {
+				fmt++;
+				flags |= CHARINT;
+			} else
+#endif
+				flags |= SHORTINT;
+			goto rflag;
+		case 'l':
+#if defined _WANT_IO_C99_FORMATS || !defined _NO_LONGLONG
+			if (*fmt == 'l') {
+				fmt++;
+				flags |= QUADINT;
+			} else
+#endif
+				flags |= LONGINT;
+			goto rflag;
+		case 'q':
+			flags |= QUADINT;
+			goto rflag;
+#ifdef _WANT_IO_C99_FORMATS
+		case 'j':
+			flags |= sizeof (intmax_t) == sizeof (long)
+				 ? LONGINT : QUADINT;
+			goto rflag;
+		case 'z':
+			if (sizeof (size_t) < sizeof (int))
+				flags |= SHORTINT;
+			else if (sizeof (size_t) > sizeof (int))
+				flags |= sizeof (size_t) <= sizeof (long)
+					 ? LONGINT : QUADINT;
+			goto rflag;
+		case 't':
+			if (sizeof (ptrdiff_t) < sizeof (int))
+				flags |= SHORTINT;
+			else if (sizeof (ptrdiff_t) > sizeof (int))
+				flags |= sizeof (ptrdiff_t) <= sizeof (long)
+					 ? LONGINT : QUADINT;
+			goto rflag;
+		case 'a': case 'A': case 'F':
+		case 'C': case 'S':
+#endif
+		case 'e': case 'E': case 'f': case 'g': case 'G':
+		case 'c': case 'd': case 'i': case 'n': case 'o':
+		case 'p': case 's': case 'u': case 'x': case 'X':
+		case 'D': case 'O': case 'U': case '%':
+			break;
+		default:
+			/* `*', `'' and anything unusual */
+			return -1;
+		}
+
+		if (ch == 'a' || ch == 'A' || ch == 'e' || ch == 'E'
+		    || ch == 'f' || ch == 'F' || ch == 'g' || ch == 'G')
+			*has_float = 1;
+		if (spec != NULL) {
+			spec[count].len = fmt - cp;
+			spec[count].flags = flags;
+			spec[count].width = width;
+			spec[count].prec = prec;
+			spec[count].sign = sign;
+			spec[count].conv = ch;
+		}
+		count++;
+	}
+}
+
+/*
+ * Compile FMT for faster printing by the printf family.  FMT is
+ * remembered by address, so it must stay valid and unchanged for the
+ * rest of the program; string literals are the intended use.  Returns
+ * 0 on success, or -1 with errno set if FMT can't be compiled (EINVAL)
+ * or memory runs out (ENOMEM).
+ */
+int
+_DEFUN(_printf_compile_r, (data, fmt),
+       struct _reent *data _AND
+       _CONST char *fmt)
+{
+	struct __pf_format *pf;
+	struct pf_table *t;
+	int count, has_float, ret = 0;
+
+	if ((count = pf_compile (data, fmt, NULL, &has_float)) < 0) {
+		data->_errno = EINVAL;
+		return -1;
+	}
+	pf = (struct __pf_format *) _malloc_r (data, sizeof *pf
+				+ (count - 1) * sizeof (struct __pf_spec));
+	if (pf == NULL) {
+		data->_errno = ENOMEM;
+		return -1;
+	}
+	pf_compile (data, fmt, pf->spec, &has_float);
+	pf->fmt = fmt;
+#ifdef _MB_CAPABLE
+	pf->mbtowc = __get_current_locale ()->mbtowc;
+#endif
+	pf->has_float = has_float;
+
+	__lock_acquire (pf_cache_lock);
+	t = pf_cache;
+	if (__pf_lookup (fmt) != NULL)
+		goto done;		/* already registered */
+	if (t == NULL || 2 * (t->count + 1) > 1U << t->bits) {
+		/* The old table stays allocated: readers may still be in
+		   it.  */
+		t = pf_rehash (data, t, t == NULL ? PF_CACHE_BITS : t->bits + 1);
+		if (t == NULL) {
+			ret = -1;
+			data->_errno = ENOMEM;
+			goto done;
+		}
+		pf_insert (t, pf);
+#ifndef __SINGLE_THREAD__
+		/* Make the new table visible before readers can find it. */
+		__sync_synchronize ();
+#endif
+		pf_cache = t;
+	} else {
+#ifndef __SINGLE_THREAD__
+		/* Make PF visible before readers can find it. */
+		__sync_synchronize ();
+#endif
+		pf_insert (t, pf);
+	}
+	pf = NULL;
+done:
+	__lock_release (pf_cache_lock);
+
+	if (pf != NULL)
+		_free_r (data, pf);
+	return ret;
+}
+
+#ifndef _REENT_ONLY
+int
+_DEFUN(printf_compile, (fmt),
+       _CONST char *fmt)
+{
+	return _printf_compile_r (_REENT, fmt);
+}
+#endif /* !_REENT_ONLY */
+
+#endif /* STRING_ONLY && INTEGER_ONLY */
+
 #ifdef FLOATING_POINT
 
 /* Using reentrant DATA, convert finite VALUE into a string of digits
@@ -2064,6 +2462,9 @@ _DEFUN(get_arg, (data, n, fmt, ap, numargs_p, args, arg_type, last_fmt),
   wchar_t wc;
   mbstate_t wc_state;
   int nbytes;
+  struct __locale_t *locale = __get_current_locale ();
+  mbtowc_p l_mbtowc = locale->mbtowc;
+  int mb_cur_max = __locale_mb_cur_max_l (locale);
 # endif
 
   /* if this isn't the first call, pick up where we left off last time */
@@ -2079,7 +2480,7 @@ _DEFUN(get_arg, (data, n, fmt, ap, numargs_p, args, arg_type, last_fmt),
   while (*fmt && n >= numargs)
     {
 # ifdef _MB_CAPABLE
-      while ((nbytes = __MBTOWC (data, &wc, fmt, MB_CUR_MAX, &wc_state)) > 0)
+      while ((nbytes = l_mbtowc (data, &wc, fmt, mb_cur_max, &wc_state)) > 0)
 	{
 	  fmt += nbytes;
 	  if (wc == '%')
@@ -244,8 +244,14 @@ static void * get_arg (int, va_list *, int *, void **);
 
 #ifndef _NO_LONGLONG
 typedef unsigned long long u_long_long;
+typedef u_long_long u_widest;	/* widest %d/%u result */
+#else
+typedef u_long u_widest;
 #endif
 
+static int scan_decimal (struct _reent *, FILE *, size_t, int, int,
+			 u_widest *);
+
 /*
  * vfscanf
  */
@@ -435,7 +441,6 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
   register char *p;		/* points into all kinds of strings */
   register int n;		/* handy integer */
   register int flags;		/* flags as defined above */
-  register char *p0;		/* saves original value of p when necessary */
   int nassigned;		/* number of fields assigned */
   int nread;			/* number of characters consumed from fp */
 #ifndef _NO_POS_ARGS
@@ -452,11 +457,16 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
   size_t mbslen;                /* length of converted multibyte sequence */
 #ifdef _MB_CAPABLE
   mbstate_t state;              /* value to keep track of multibyte state */
+  struct __locale_t *locale = __get_current_locale ();
+  mbtowc_p l_mbtowc = locale->mbtowc; /* looked up once per call */
+  int mb_cur_max = __locale_mb_cur_max_l (locale);
 #endif
 
   #define CCFN_PARAMS	_PARAMS((struct _reent *, const char *, char **, int))
   u_long (*ccfn)CCFN_PARAMS=0;	/* conversion function (strtol/strtoul) */
   char ccltab[256];		/* character class table for %[...] */
+  u_char *ccl_fmt = NULL;	/* format text ccltab was built from */
+  size_t ccl_len = 0;		/* and its length */
   char buf[BUF];		/* buffer for numeric conversions */
   unsigned char *lptr;          /* literal pointer */
 
@@ -508,7 +518,7 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
 #ifndef _MB_CAPABLE
       wc = *fmt;
 #else
-      nbytes = __MBTOWC (rptr, &wc, (char *) fmt, MB_CUR_MAX, &state);
+      nbytes = l_mbtowc (rptr, &wc, (char *) fmt, mb_cur_max, &state);
       if (nbytes < 0) {
 	wc = 0xFFFD; /* Unicode replacement character */
 	nbytes = 1;
@@ -729,7 +739,16 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
 	  break;
 
 	case '[':
-	  fmt = (u_char *) __sccl (ccltab, (unsigned char *) fmt);
+	  /* The same scanset again, as in "%[^,],%[^,]", is in ccltab.  */
+	  if (ccl_len != 0
+	      && strncmp ((char *) fmt, (char *) ccl_fmt, ccl_len) == 0)
+	    fmt += ccl_len;
+	  else
+	    {
+	      ccl_fmt = fmt;
+	      fmt = (u_char *) __sccl (ccltab, (unsigned char *) fmt);
+	      ccl_len = fmt - ccl_fmt;
+	    }
 	  flags |= NOSKIP;
 	  c = CT_CCL;
 	  break;
@@ -926,43 +945,34 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
 	  if (width == 0)
 	    width = ~0;		/* `infinity' */
 	  /* take only those things in the class */
-	  if (flags & SUPPRESS)
+	  /* take one buffer's worth at a time */
+	  p = (flags & SUPPRESS) ? NULL : GET_ARG (N, ap, char *);
+	  n = 0;
+	  for (;;)
 	    {
-	      n = 0;
-	      while (ccltab[*fp->_p])
+	      u_char *s = fp->_p;
+	      u_char *e = s + ((size_t) fp->_r < width ? (size_t) fp->_r : width);
+	      size_t run;
+
+	      while (s < e && ccltab[*s])
+		s++;
+	      run = s - fp->_p;
+	      if (p != NULL)
 		{
-		  n++, fp->_r--, fp->_p++;
-		  if (--width == 0)
-		    break;
-		  if (BufferEmpty)
-		    {
-		      if (n == 0)
-			goto input_failure;
-		      break;
-		    }
+		  memcpy (p, fp->_p, run);
+		  p += run;
 		}
-	      if (n == 0)
-		goto match_failure;
+	      n += run;
+	      fp->_r -= run;
+	      fp->_p = s;
+	      width -= run;
+	      if (s < e || width == 0 || BufferEmpty)
+		break;
 	    }
-	  else
+	  if (n == 0)
+	    goto match_failure;
+	  if (p != NULL)
 	    {
-	      p0 = p = GET_ARG (N, ap, char *);
-	      while (ccltab[*fp->_p])
-		{
-		  fp->_r--;
-		  *p++ = *fp->_p++;
-		  if (--width == 0)
-		    break;
-		  if (BufferEmpty)
-		    {
-		      if (p == p0)
-			goto input_failure;
-		      break;
-		    }
-		}
-	      n = p - p0;
-	      if (n == 0)
-		goto match_failure;
 	      *p = 0;
 	      nassigned++;
 	    }
@@ -1025,34 +1035,36 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
             }
           else
 #endif
-        	  if (flags & SUPPRESS)
 	    {
-	      n = 0;
-	      while (!isspace (*fp->_p))
+	      /* take one buffer's worth at a time */
+	      p = (flags & SUPPRESS) ? NULL : GET_ARG (N, ap, char *);
+	      for (;;)
 		{
-		  n++, fp->_r--, fp->_p++;
-		  if (--width == 0)
-		    break;
-		  if (BufferEmpty)
+		  u_char *s = fp->_p;
+		  u_char *e = s + ((size_t) fp->_r < width
+				   ? (size_t) fp->_r : width);
+		  size_t run;
+
+		  while (s < e && !isspace (*s))
+		    s++;
+		  run = s - fp->_p;
+		  if (p != NULL)
+		    {
+		      memcpy (p, fp->_p, run);
+		      p += run;
+		    }
+		  nread += run;
+		  fp->_r -= run;
+		  fp->_p = s;
+		  width -= run;
+		  if (s < e || width == 0 || BufferEmpty)
 		    break;
 		}
-	      nread += n;
-	    }
-	  else
-	    {
-	      p0 = p = GET_ARG (N, ap, char *);
-	      while (!isspace (*fp->_p))
+	      if (p != NULL)
 		{
-		  fp->_r--;
-		  *p++ = *fp->_p++;
-		  if (--width == 0)
-		    break;
-		  if (BufferEmpty)
-		    break;
+		  *p = 0;
+		  nassigned++;
 		}
-	      *p = 0;
-	      nread += p - p0;
-	      nassigned++;
 	    }
 	  continue;
 
@@ -1061,6 +1073,16 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
 	  /* scan an integer as if by strtol/strtoul */
 	  unsigned width_left = 0;
 	  int skips = 0;
+	  u_widest val;
+
+	  /* Plain decimal fields are converted straight from the buffer.  */
+	  if (base == 10 && width < sizeof (buf)
+	      && (n = scan_decimal (rptr, fp, width, flags,
+				    ccfn == _strtoul_r, &val)) != 0)
+	    {
+	      p = NULL;
+	      goto int_store;
+	    }
 #ifdef hardway
 	  if (width == 0 || width > sizeof (buf) - 1)
 #else
@@ -1212,61 +1234,63 @@ _DEFUN(__SVFSCANF_R, (rptr, fp, fmt0, ap),
 	    }
 	  if ((flags & SUPPRESS) == 0)
 	    {
-	      u_long res;
-
 	      *p = 0;
-	      res = (*ccfn) (rptr, buf, (char **) NULL, base);
-	      if (flags & POINTER)
-		{
-		  void **vp = GET_ARG (N, ap, void **);
 #ifndef _NO_LONGLONG
-		  if (sizeof (uintptr_t) > sizeof (u_long))
-		    {
-		      u_long_long resll;
-		      resll = _strtoull_r (rptr, buf, (char **) NULL, base);
-		      *vp = (void *) (uintptr_t) resll;
-		    }
+	      if ((flags & POINTER) ? sizeof (uintptr_t) > sizeof (u_long)
+				    : (flags & (CHAR | SHORT | LONG | LONGDBL))
+				      == LONGDBL)
+		{
+		  if (ccfn == _strtoul_r)
+		    val = _strtoull_r (rptr, buf, (char **) NULL, base);
 		  else
+		    val = _strtoll_r (rptr, buf, (char **) NULL, base);
+		}
+	      else
 #endif /* !_NO_LONGLONG */
-		    *vp = (void *) (uintptr_t) res;
+		val = (*ccfn) (rptr, buf, (char **) NULL, base);
+	    }
+	  n = p - buf + skips;
+
+	int_store:
+	  if ((flags & SUPPRESS) == 0)
+	    {
+	      if (flags & POINTER)
+		{
+		  void **vp = GET_ARG (N, ap, void **);
+		  *vp = (void *) (uintptr_t) val;
 		}
 #ifdef _WANT_IO_C99_FORMATS
 	      else if (flags & CHAR)
 		{
 		  cp = GET_ARG (N, ap, char *);
-		  *cp = res;
+		  *cp = val;
 		}
 #endif
 	      else if (flags & SHORT)
 		{
 		  sp = GET_ARG (N, ap, short *);
-		  *sp = res;
+		  *sp = val;
 		}
 	      else if (flags & LONG)
 		{
 		  lp = GET_ARG (N, ap, long *);
-		  *lp = res;
+		  *lp = val;
 		}
 #ifndef _NO_LONGLONG
 	      else if (flags & LONGDBL)
 		{
-		  u_long_long resll;
-		  if (ccfn == _strtoul_r)
-		    resll = _strtoull_r (rptr, buf, (char **) NULL, base);
-		  else
-		    resll = _strtoll_r (rptr, buf, (char **) NULL, base);
 		  llp = GET_ARG (N, ap, long long*);
-		  *llp = resll;
+		  *llp = val;
 		}
 #endif
 	      else
 		{
 		  ip = GET_ARG (N, ap, int *);
-		  *ip = res;
+		  *ip = val;
 		}
 	      nassigned++;
 	    }
-	  nread += p - buf + skips;
+	  nread += n;
 	  break;
 	}
 #ifdef FLOATING_POINT
@@ -1658,3 +1682,101 @@ get_arg (int n, va_list *ap, int *numargs_p, void **args)
   return args[n];
 }
 #endif /* !_NO_POS_ARGS */
+
+/*
+ * Scan a %d or %u field straight from the stream buffer, converting as
+ * we go instead of staging the characters in buf for strtol.  The
+ * characters taken are the ones the general CT_INT loop would take, and
+ * the value is what strtol or strtoul (strtoll or strtoull for %lld and
+ * %llu) would return for them, saturating and setting ERANGE on
+ * overflow unless the field is suppressed.  Returns the number of
+ * characters consumed, or 0 without consuming anything if the field
+ * does not begin with [sign] digit in the buffer; the caller then takes
+ * the general path.
+ */
+static int
+scan_decimal (struct _reent *rptr, FILE *fp, size_t width, int flags,
+	      int is_unsigned, u_widest *valp)
+{
+  u_char *p, *e;
+  u_widest acc, max, cutoff;
+  int c, cutlim, neg, nonzero, zero, ovf, nread;
+  size_t room;
+
+  p = fp->_p;
+  e = p + fp->_r;
+  /* An unbounded field keeps at most sizeof (buf) - 1 characters, not
+     counting leading zeros after the first; a bounded one counts all.  */
+  room = width ? width : BUF - 1;
+  neg = 0;
+  if (*p == '+' || *p == '-')
+    {
+      if (e - p < 2 || room < 2 || (unsigned) (p[1] - '0') > 9)
+	return 0;
+      neg = *p++ == '-';
+      room--;
+    }
+  else if ((unsigned) (*p - '0') > 9)
+    return 0;
+
+#ifndef _NO_LONGLONG
+  if ((flags & (CHAR | SHORT | LONG | LONGDBL)) == LONGDBL)
+    max = is_unsigned ? ULLONG_MAX
+	  : neg ? (u_widest) LLONG_MAX + 1 : LLONG_MAX;
+  else
+#endif
+    max = is_unsigned ? ULONG_MAX
+	  : neg ? (u_widest) LONG_MAX + 1 : LONG_MAX;
+  cutoff = max / 10;
+  cutlim = max % 10;
+
+  acc = 0;
+  nonzero = zero = ovf = nread = 0;
+  while (room != 0 && (unsigned) (c = *p - '0') <= 9)
+    {
+      if (c == 0 && !nonzero && zero)
+	{
+	  /* Further leading zeros are skipped, as in the general loop.  */
+	  if (width)
+	    room--;
+	}
+      else
+	{
+	  room--;
+	  if (c == 0)
+	    zero = 1;
+	  else
+	    nonzero = 1;
+	  if (ovf || acc > cutoff || (acc == cutoff && c > cutlim))
+	    ovf = 1;
+	  else
+	    acc = acc * 10 + c;
+	}
+      if (++p == e)
+	{
+	  nread += p - fp->_p;
+	  fp->_r = 0;
+	  fp->_p = p;
+	  if (__srefill_r (rptr, fp))
+	    {
+	      p = fp->_p;
+	      break;
+	    }
+	  p = fp->_p;
+	  e = p + fp->_r;
+	}
+    }
+  nread += p - fp->_p;
+  fp->_r -= p - fp->_p;
+  fp->_p = p;
+
+  if (ovf)
+    {
+      if ((flags & SUPPRESS) == 0)
+	rptr->_errno = ERANGE;
+      *valp = is_unsigned || !neg ? max : -max;
+    }
+  else
+    *valp = neg ? -acc : acc;
+  return nread;
+}
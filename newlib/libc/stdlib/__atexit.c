@@ -40,6 +40,7 @@
 
 /* Make this a weak reference to avoid pulling in malloc.  */
 void * malloc(size_t) _ATTRIBUTE((__weak__));
+void * realloc(void *, size_t) _ATTRIBUTE((__weak__));
 
 #ifdef _LITE_EXIT
 /* As __call_exitprocs is weak reference in lite exit, make a
@@ -58,6 +59,62 @@ static struct _atexit _global_atexit0 = _ATEXIT_INIT;
 # define _GLOBAL_ATEXIT0 (&_GLOBAL_REENT->_atexit0)
 #endif
 
+#ifdef _ATEXIT_DYNAMIC_ALLOC
+
+/*
+ * Note that slot N of block P holds a handler for DSO D.  On failure the
+ * index is abandoned.
+ */
+
+static void
+_DEFUN (register_dso_ref,
+	(d, p, n),
+	void *d _AND
+	struct _atexit *p _AND
+	int n)
+{
+  struct _atexit_dso *dso;
+  struct _atexit_ref *refs;
+
+  if (__atexit_dso_broken)
+    return;
+  if (!realloc)
+    goto broken;
+
+  for (dso = __atexit_dso[_ATEXIT_DSO_HASH (d)]; dso; dso = dso->_next)
+    if (dso->_dso == d)
+      break;
+  if (dso == NULL)
+    {
+      dso = (struct _atexit_dso *) malloc (sizeof *dso);
+      if (dso == NULL)
+	goto broken;
+      dso->_dso = d;
+      dso->_count = dso->_size = dso->_active = 0;
+      dso->_refs = NULL;
+      dso->_next = __atexit_dso[_ATEXIT_DSO_HASH (d)];
+      __atexit_dso[_ATEXIT_DSO_HASH (d)] = dso;
+    }
+  if (dso->_count == dso->_size)
+    {
+      refs = (struct _atexit_ref *)
+	realloc (dso->_refs, 2 * (dso->_size + 4) * sizeof *refs);
+      if (refs == NULL)
+	goto broken;
+      dso->_refs = refs;
+      dso->_size = 2 * (dso->_size + 4);
+    }
+  dso->_refs[dso->_count]._block = p;
+  dso->_refs[dso->_count]._ind = n;
+  dso->_count++;
+  return;
+
+broken:
+  __atexit_dso_broken = 1;
+}
+
+#endif /* _ATEXIT_DYNAMIC_ALLOC */
+
 /*
  * Register a function to be performed at exit or on shared library unload.
  */
@@ -162,6 +219,10 @@ _DEFUN (__register_exitproc,
 	args->_is_cxa |= (1 << p->_ind);
     }
   p->_fns[p->_ind++] = fn;
+#ifdef _ATEXIT_DYNAMIC_ALLOC
+  if (type == __et_cxa && d != NULL)
+    register_dso_ref (d, p, p->_ind - 1);
+#endif
 #ifndef __SINGLE_THREAD__
   __lock_release_recursive(__atexit_lock);
 #endif
@@ -17,6 +17,11 @@ __LOCK_INIT_RECURSIVE(, __atexit_lock);
 struct _atexit *_global_atexit = _NULL;
 #endif
 
+#ifdef _ATEXIT_DYNAMIC_ALLOC
+struct _atexit_dso *__atexit_dso[_ATEXIT_DSO_BUCKETS];
+int __atexit_dso_broken;
+#endif
+
 #ifdef _WANT_REGISTER_FINI
 
 /* If "__libc_fini" is defined, finalizers (either
@@ -57,6 +62,89 @@ register_fini(void)
 
 #endif /* _WANT_REGISTER_FINI  */
 
+#ifdef _ATEXIT_DYNAMIC_ALLOC
+
+/*
+ * Call the handlers of DSO D through the index, newest first, removing
+ * each from its block just as __call_exitprocs would.  Handlers that
+ * they register for D are called before the older ones.
+ */
+
+static void
+_DEFUN (call_dso_exitprocs, (d),
+	_PTR d)
+{
+  struct _atexit_dso *dso, **dsop;
+  struct _atexit *p;
+  struct _on_exit_args *args;
+  int n, i;
+  void (*fn) (void);
+
+  for (dso = __atexit_dso[_ATEXIT_DSO_HASH (d)]; dso; dso = dso->_next)
+    if (dso->_dso == d)
+      break;
+  if (dso == NULL)
+    return;
+
+  dso->_active++;
+  while (dso->_count > 0 && !__atexit_dso_broken)
+    {
+      dso->_count--;
+      p = dso->_refs[dso->_count]._block;
+      n = dso->_refs[dso->_count]._ind;
+#ifdef _REENT_SMALL
+      args = p->_on_exit_args_ptr;
+#else
+      args = &p->_on_exit_args;
+#endif
+      i = 1 << n;
+
+      fn = p->_fns[n];
+      p->_fns[n] = NULL;
+      args->_fntypes &= ~i;
+      args->_is_cxa &= ~i;
+      args->_dso_handle[n] = NULL;
+      /* Drop called handlers from the top of the block, so that their
+	 slots can be reused, and the block freed once empty.  Indexed
+	 handlers all come from __cxa_atexit.  */
+      while (p->_ind > 0 && p->_fns[p->_ind - 1] == NULL)
+	p->_ind--;
+
+      if (fn)
+	(*((void (*)(_PTR)) fn))(args->_fnargs[n]);
+    }
+  dso->_active--;
+
+  if (__atexit_dso_broken)
+    return;
+
+  /* Free the index entry once no other call is using it.  */
+  if (dso->_count == 0 && dso->_active == 0)
+    {
+      for (dsop = &__atexit_dso[_ATEXIT_DSO_HASH (d)]; *dsop != dso;
+	   dsop = &(*dsop)->_next)
+	;
+      *dsop = dso->_next;
+      free (dso->_refs);
+      free (dso);
+    }
+
+  /* Free emptied blocks at the head of the list, except the last one,
+     which is part of _GLOBAL_REENT.  Handlers still to be called never
+     live in an empty block, so no index entry refers to these.  */
+  while ((p = _GLOBAL_ATEXIT) != NULL && p->_ind == 0 && p->_next)
+    {
+      _GLOBAL_ATEXIT = p->_next;
+#ifdef _REENT_SMALL
+      if (p->_on_exit_args_ptr)
+	free (p->_on_exit_args_ptr);
+#endif
+      free (p);
+    }
+}
+
+#endif /* _ATEXIT_DYNAMIC_ALLOC */
+
 /*
  * Call registered exit handlers.  If D is null then all handlers are called,
  * otherwise only the handlers from that DSO are called.
@@ -78,6 +166,25 @@ _DEFUN (__call_exitprocs, (code, d),
   __lock_acquire_recursive(__atexit_lock);
 #endif
 
+#ifdef _ATEXIT_DYNAMIC_ALLOC
+  if (d != NULL && !__atexit_dso_broken && free)
+    {
+      call_dso_exitprocs (d);
+      /* If the index was abandoned meanwhile, scan for the rest.  */
+      if (!__atexit_dso_broken)
+	{
+#ifndef __SINGLE_THREAD__
+	  __lock_release_recursive(__atexit_lock);
+#endif
+	  return;
+	}
+    }
+  /* exit may call handlers out of the index's order, and frees blocks
+     it refers to.  */
+  if (d == NULL)
+    __atexit_dso_broken = 1;
+#endif
+
  restart:
 
   p = _GLOBAL_ATEXIT;
@@ -35,6 +35,7 @@
 
 #define KEYSTREAM_ONLY
 #include "chacha_private.h"
+#include "local.h"
 
 #define min(a, b) ((a) < (b) ? (a) : (b))
 #ifdef __GNUC__
@@ -47,15 +48,28 @@
 #define IVSZ	8
 #define BLOCKSZ	64
 #define RSBUFSZ	(16*BLOCKSZ)
+#define BULKSZ	(CHACHA_LANES*BLOCKSZ)
+
+#include <machine/_arc4random.h>
+
+#ifdef _ARC4RANDOM_THREAD_LOCAL
+#define _RS_THREAD_LOCAL _ARC4RANDOM_THREAD_LOCAL
+#else
+#define _RS_THREAD_LOCAL
+#endif
 
 /* Marked MAP_INHERIT_ZERO, so zero'd out in fork children. */
-static struct _rs {
+static _RS_THREAD_LOCAL struct _rs {
 	size_t		rs_have;	/* valid bytes at end of rs_buf */
 	size_t		rs_count;	/* bytes till reseed */
+	unsigned int	rs_forkgen;	/* fork generation when seeded */
 } *rs;
 
+/* Bumped in every fork child, see _arc4random_fork_child(). */
+static volatile unsigned int _arc4random_forkgen;
+
 /* Maybe be preserved in fork children, if _rs_allocate() decides. */
-static struct _rsx {
+static _RS_THREAD_LOCAL struct _rsx {
 	chacha_ctx	rs_chacha;	/* chacha context for random keystream */
 	u_char		rs_buf[RSBUFSZ];	/* keystream blocks */
 } *rsx;
@@ -100,6 +114,7 @@ _rs_stir(void)
 	memset(rsx->rs_buf, 0, sizeof(rsx->rs_buf));
 
 	rs->rs_count = 1600000;
+	rs->rs_forkgen = _arc4random_forkgen;
 }
 
 static inline void
@@ -161,6 +176,30 @@ _rs_random_buf(void *_buf, size_t n)
 	}
 }
 
+/*
+ * Large requests get a cipher of their own, keyed from the shared
+ * generator, so the lock is held only while the key is drawn.
+ */
+static void
+_rs_random_bulk(void *_buf, size_t n)
+{
+	u_char *buf = (u_char *)_buf;
+	u_char rnd[KEYSZ + IVSZ];
+	chacha_ctx ctx;
+
+	_ARC4_LOCK();
+	_rs_random_buf(rnd, sizeof(rnd));
+	_ARC4_UNLOCK();
+
+	chacha_keysetup(&ctx, rnd, KEYSZ * 8, 0);
+	chacha_ivsetup(&ctx, rnd + KEYSZ);
+	explicit_bzero(rnd, sizeof(rnd));
+	for (; n >= BULKSZ; buf += BULKSZ, n -= BULKSZ)
+		chacha_keystream_lanes(&ctx, buf);
+	chacha_encrypt_bytes(&ctx, buf, buf, n);
+	explicit_bzero(&ctx, sizeof(ctx));
+}
+
 static inline void
 _rs_random_u32(uint32_t *val)
 {
@@ -189,7 +228,18 @@ arc4random(void)
 void
 arc4random_buf(void *buf, size_t n)
 {
+	if (n >= BULKSZ) {
+		_rs_random_bulk(buf, n);
+		return;
+	}
 	_ARC4_LOCK();
 	_rs_random_buf(buf, n);
 	_ARC4_UNLOCK();
 }
+
+/* Called by the port in the child of each fork. */
+void
+_arc4random_fork_child(void)
+{
+	_arc4random_forkgen++;
+}
@@ -31,13 +31,35 @@
  *  o _ARC4RANDOM_GETENTROPY_FAIL(),
  *  o _ARC4RANDOM_ALLOCATE(rsp, rspx), and
  *  o _ARC4RANDOM_FORKDETECT().
+ *
+ * Unless the port supplies _ARC4RANDOM_FORKDETECT(), its fork() should
+ * call _arc4random_fork_child() in the child: that bumps a generation
+ * count, and a state seeded under an older count is reseeded.  This
+ * keeps fork children safe without a getpid() call per request.
+ *
+ * A port with thread-local storage may define _ARC4RANDOM_THREAD_LOCAL
+ * to its storage class keyword.  Each thread then gets its own
+ * generator, seeded on first use and reseeded on its own schedule,
+ * and no lock is taken.  The Linux port does both.
  */
 #include <machine/_arc4random.h>
 
 #include <sys/lock.h>
 #include <signal.h>
 
-#ifndef _ARC4_LOCK_INIT
+#ifdef _ARC4RANDOM_THREAD_LOCAL
+
+#undef _ARC4_LOCK_INIT
+#undef _ARC4_LOCK
+#undef _ARC4_UNLOCK
+
+#define _ARC4_LOCK_INIT
+
+#define _ARC4_LOCK() do { } while (0)
+
+#define _ARC4_UNLOCK() do { } while (0)
+
+#elif !defined(_ARC4_LOCK_INIT)
 
 #define _ARC4_LOCK_INIT __LOCK_INIT(static, _arc4random_mutex);
 
@@ -52,7 +74,7 @@ _ARC4_LOCK_INIT
 #ifdef _ARC4RANDOM_DATA
 _ARC4RANDOM_DATA
 #else
-static struct {
+static _RS_THREAD_LOCAL struct {
 	struct _rs rs;
 	struct _rsx rsx;
 } _arc4random_data;
@@ -85,5 +107,9 @@ _rs_forkdetect(void)
 {
 #ifdef _ARC4RANDOM_FORKDETECT
 	_ARC4RANDOM_FORKDETECT();
+#else
+	/* A fork child starts out with a copy of its parent's state. */
+	if (rs != NULL && rs->rs_forkgen != _arc4random_forkgen)
+		rs->rs_count = 0;
 #endif
 }
@@ -12,3 +12,38 @@ enum __atexit_types
 void __call_exitprocs _PARAMS ((int, _PTR));
 int __register_exitproc _PARAMS ((int, void (*fn) (void), _PTR, _PTR));
 
+#ifdef _ATEXIT_DYNAMIC_ALLOC
+
+/* Handlers registered by __cxa_atexit for one DSO, oldest first, so
+   that __cxa_finalize need not look at those of other DSOs.  Each
+   reference names a slot of a block on the _GLOBAL_ATEXIT list that
+   has not been called yet.  */
+struct _atexit_ref
+{
+  struct _atexit *_block;
+  int _ind;
+};
+
+struct _atexit_dso
+{
+  struct _atexit_dso *_next;		/* next in hash bucket */
+  _PTR _dso;
+  int _count;				/* references in use */
+  int _size;				/* references allocated */
+  int _active;				/* __cxa_finalize calls running */
+  struct _atexit_ref *_refs;
+};
+
+#define _ATEXIT_DSO_BUCKETS 64
+#define _ATEXIT_DSO_HASH(d) \
+  (((unsigned int) ((unsigned long) (d) >> 4) * 2654435761U >> 26) \
+   & (_ATEXIT_DSO_BUCKETS - 1))
+
+/* Protected by __atexit_lock.  Once __atexit_dso_broken is set, because
+   memory ran out or exit has started, the index is no longer kept and
+   __cxa_finalize scans every handler as before.  */
+extern struct _atexit_dso *__atexit_dso[_ATEXIT_DSO_BUCKETS];
+extern int __atexit_dso_broken;
+
+#endif /* _ATEXIT_DYNAMIC_ALLOC */
+
@@ -219,3 +219,55 @@ chacha_encrypt_bytes(chacha_ctx *x,const u8 *m,u8 *c,u32 bytes)
 #endif
   }
 }
+
+#define CHACHA_LANES 4
+
+#define LANE_QUARTERROUND(a,b,c,d) \
+  for (l = 0;l < CHACHA_LANES;++l) { \
+    QUARTERROUND(s[a][l],s[b][l],s[c][l],s[d][l]) \
+  }
+
+/*
+ * Write the keystream for the next CHACHA_LANES blocks to c, as
+ * chacha_encrypt_bytes would with KEYSTREAM_ONLY.  The blocks are
+ * computed side by side, one array column per block, so the compiler
+ * can keep each state word of all blocks in one vector register.
+ */
+static void
+chacha_keystream_lanes(chacha_ctx *x,u8 *c)
+{
+  u32 s[16][CHACHA_LANES];
+  u32 j[16][CHACHA_LANES];
+  u_int i, k, l;
+
+  for (k = 0;k < 16;++k)
+    for (l = 0;l < CHACHA_LANES;++l)
+      j[k][l] = x->input[k];
+  for (l = 0;l < CHACHA_LANES;++l) {
+    j[12][l] = PLUS(x->input[12],l);
+    if (j[12][l] < x->input[12]) j[13][l] = PLUSONE(x->input[13]);
+  }
+  for (k = 0;k < 16;++k)
+    for (l = 0;l < CHACHA_LANES;++l)
+      s[k][l] = j[k][l];
+
+  for (i = 20;i > 0;i -= 2) {
+    LANE_QUARTERROUND( 0, 4, 8,12)
+    LANE_QUARTERROUND( 1, 5, 9,13)
+    LANE_QUARTERROUND( 2, 6,10,14)
+    LANE_QUARTERROUND( 3, 7,11,15)
+    LANE_QUARTERROUND( 0, 5,10,15)
+    LANE_QUARTERROUND( 1, 6,11,12)
+    LANE_QUARTERROUND( 2, 7, 8,13)
+    LANE_QUARTERROUND( 3, 4, 9,14)
+  }
+
+  for (l = 0;l < CHACHA_LANES;++l)
+    for (k = 0;k < 16;++k)
+      U32TO8_LITTLE(c + 64 * l + 4 * k,PLUS(s[k][l],j[k][l]));
+
+  x->input[12] = PLUS(x->input[12],CHACHA_LANES);
+  if (x->input[12] < CHACHA_LANES) {
+    x->input[13] = PLUSONE(x->input[13]);
+  }
+}
@@ -6,6 +6,7 @@
 #include <reent.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "mprec.h"
 
 /* These are the externally visible entries. */
@@ -85,6 +86,10 @@ static void efloor (short unsigned int *x, short unsigned int *y,
 		    LDPARMS * ldp);
 static void etoasc (short unsigned int *x, char *string, int ndigs,
 		    int outformat, LDPARMS * ldp);
+#if LDBL_MANT_DIG == 64 || LDBL_MANT_DIG == 113
+static int etoasc_exact (short unsigned int *x, char *string, int ndigits,
+			 int outformat, LDPARMS * ldp);
+#endif
 
 union uconv
 {
@@ -2774,6 +2779,473 @@ _IO_ldtostr (x, string, ndigs, flags, fmt)
 
 #endif
 
+#if LDBL_MANT_DIG == 64 || LDBL_MANT_DIG == 113
+
+/* Exact conversion for the IEEE long double formats.
+
+   The number is S * 2^b with S its significand taken as an integer.
+   The digits wanted are those of floor (S * 2^b * 10^j) for the j that
+   gives etoasc's digit count, and the part cut off only matters as far
+   as it is zero, below one half, one half or above it.  All of that is
+   worked out in plain integer arithmetic on word arrays kept on the
+   stack, which is both faster than the emulated arithmetic and exact
+   where the latter runs out of bits.  The string and ldp->outexpon come
+   out in the same form as etoasc's, rounded to nearest with ties to
+   even as there.  Returns nonzero for anything better left to etoasc.  */
+
+/* Words for S * 10^j with the smallest denormal, and base 10^9 limbs
+   for the integer part of the largest number.  */
+#define NBIG ((LDBL_MAX_EXP + LDBL_MANT_DIG + 4 * NDEC) / 29 + 2)
+#define BIGBASE 1000000000
+
+static _CONST uint32_t pow10_9[9] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+/* a = a * m, in n binary words, least significant first.  */
+static int
+bin_mul (uint32_t * a, int n, uint32_t m)
+{
+  uint64_t x, c = 0;
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      x = (uint64_t) a[i] * m + c;
+      a[i] = (uint32_t) x;
+      c = x >> 32;
+    }
+  if (c != 0)
+    a[n++] = (uint32_t) c;
+  return n;
+}
+
+/* a = a * m, in n base 10^9 limbs, least significant first; m <= 2^29.  */
+static int
+dec_mul (uint32_t * a, int n, uint32_t m)
+{
+  uint64_t x, c = 0;
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      x = (uint64_t) a[i] * m + c;
+      a[i] = (uint32_t) (x % BIGBASE);
+      c = x / BIGBASE;
+    }
+  if (c != 0)
+    a[n++] = (uint32_t) c;
+  return n;
+}
+
+/* Convert the n binary words of w, which are lost, to base 10^9 limbs.  */
+static int
+bin_to_dec (uint32_t * w, int n, uint32_t * d)
+{
+  uint64_t x;
+  uint32_t r;
+  int i, nd = 0;
+
+  while (n > 0 && w[n - 1] == 0)
+    n--;
+  while (n > 0)
+    {
+      r = 0;
+      for (i = n - 1; i >= 0; i--)
+	{
+	  x = ((uint64_t) r << 32) | w[i];
+	  w[i] = (uint32_t) (x / BIGBASE);
+	  r = (uint32_t) (x % BIGBASE);
+	}
+      d[nd++] = r;
+      while (n > 0 && w[n - 1] == 0)
+	n--;
+    }
+  return nd;
+}
+
+/* Number of decimal digits in the nd limbs of d.  */
+static int
+dec_len (_CONST uint32_t * d, int nd)
+{
+  int k;
+
+  if (nd == 0)
+    return 0;
+  for (k = 1; k < 9 && d[nd - 1] >= pow10_9[k]; k++)
+    ;
+  return 9 * (nd - 1) + k;
+}
+
+/* Decimal digit i of d, counting from the least significant one.  */
+static int
+dec_digit (_CONST uint32_t * d, int i)
+{
+  return d[i / 9] / pow10_9[i % 9] % 10;
+}
+
+/* Nonzero if any of the i least significant digits of d is.  */
+static int
+dec_sticky (_CONST uint32_t * d, int i)
+{
+  int k;
+
+  if (d[i / 9] % pow10_9[i % 9] != 0)
+    return 1;
+  for (k = i / 9 - 1; k >= 0; k--)
+    if (d[k] != 0)
+      return 1;
+  return 0;
+}
+
+/* Fixed precision numbers for large decimal exponents: w * 2^e, with
+   the top bit of w[NAPX - 1] set.  Every product is truncated, so a
+   power of ten made with up to thirteen squarings and as many products
+   is within a relative 2^-238 of the true one.  */
+#define NAPX 8
+
+typedef struct
+{
+  uint32_t w[NAPX];
+  int e;
+} APX;
+
+/* c = a * b; c may be a or b.  */
+static void
+apx_mul (_CONST APX * a, _CONST APX * b, APX * c)
+{
+  uint32_t p[2 * NAPX];
+  uint64_t x;
+  int i, k;
+
+  memset (p, 0, sizeof (p));
+  for (i = 0; i < NAPX; i++)
+    {
+      x = 0;
+      for (k = 0; k < NAPX; k++)
+	{
+	  x += (uint64_t) a->w[i] * b->w[k] + p[i + k];
+	  p[i + k] = (uint32_t) x;
+	  x >>= 32;
+	}
+      p[i + NAPX] = (uint32_t) x;
+    }
+  c->e = a->e + b->e + 32 * NAPX;
+  if ((p[2 * NAPX - 1] & 0x80000000) == 0)
+    {
+      for (i = 2 * NAPX - 1; i > 0; i--)
+	p[i] = (p[i] << 1) | (p[i - 1] >> 31);
+      c->e -= 1;
+    }
+  for (i = 0; i < NAPX; i++)
+    c->w[i] = p[i + NAPX];
+}
+
+/* r = 10^j, j != 0.  */
+static void
+apx_pow10 (int j, APX * r)
+{
+  APX base;
+  int i, first;
+
+  for (i = 0; i < NAPX; i++)
+    base.w[i] = j < 0 ? 0xcccccccc : 0;
+  if (j < 0)
+    {
+      base.w[0] = 0xcccccccd;
+      base.e = -3 - 32 * NAPX;
+      j = -j;
+    }
+  else
+    {
+      base.w[NAPX - 1] = 0xa0000000;
+      base.e = 4 - 32 * NAPX;
+    }
+  for (first = 1;; j >>= 1)
+    {
+      if (j & 1)
+	{
+	  if (first)
+	    *r = base;
+	  else
+	    apx_mul (r, &base, r);
+	  first = 0;
+	}
+      if (j == 1)
+	break;
+      apx_mul (&base, &base, &base);
+    }
+}
+
+/* The 32 bits of the n words of y from bit pos up.  */
+static uint32_t
+bits32 (_CONST uint32_t * y, int n, int pos)
+{
+  uint32_t r = 0;
+  int i = pos / 32;
+
+  if (i < n)
+    r = y[i] >> pos % 32;
+  if (pos % 32 != 0 && i + 1 < n)
+    r |= y[i + 1] << (32 - pos % 32);
+  return r;
+}
+
+/* floor (S * 2^b * 10^j) into q, for S * 2^b * 10^j < 2^150, and in
+   *state whether the rest is below one half (1) or above it (3).
+   Returns the number of words of q, or -1 if the approximation is too
+   close to call, which it always is for an exact zero or half.  */
+static int
+apx_scale (_CONST uint32_t * sw, int ns, int b, int j, uint32_t * q,
+	   int *state)
+{
+  APX f;
+  uint32_t y[(NE + 1) / 2 + NAPX], r;
+  uint64_t x;
+  int i, k, ny, sh;
+
+  apx_pow10 (j, &f);
+  ny = ns + NAPX;
+  memset (y, 0, sizeof (y));
+  for (i = 0; i < ns; i++)
+    {
+      x = 0;
+      for (k = 0; k < NAPX; k++)
+	{
+	  x += (uint64_t) sw[i] * f.w[k] + y[i + k];
+	  y[i + k] = (uint32_t) x;
+	  x >>= 32;
+	}
+      y[i + NAPX] = (uint32_t) x;
+    }
+
+/* The error is below 2^-80; decide on the top 32 bits of the fraction.  */
+  while (y[ny - 1] == 0)
+    ny--;
+  sh = -(f.e + b);
+  if (sh < 32 || 32 * ny - sh > 32 * 6)
+    return -1;
+  r = bits32 (y, ny, sh - 32);
+  if (r == 0 || r == 0x7fffffff || r == 0x80000000 || r == 0xffffffff)
+    return -1;
+  *state = r < 0x80000000 ? 1 : 3;
+  for (i = 0; sh < 32 * ny; i++, sh += 32)
+    q[i] = bits32 (y, ny, sh);
+  return i;
+}
+
+static int
+etoasc_exact (short unsigned int *x, char *string, int ndigits,
+	      int outformat, LDPARMS * ldp)
+{
+  uint32_t big[NBIG], qw[8], sw[(NE + 1) / 2];
+  char digs[NDEC + 4];
+  int i, j, k, n, nb, ns, nd, lo, b, e2, est, exp, expon, ndigs;
+  int limit, state;
+  char *s;
+
+  exp = x[NE - 1] & 0x7fff;
+  if (exp == 0x7fff)
+    return -1;
+  if (exp != 0 && (x[NE - 2] & 0x8000) == 0)
+    return -1;
+  s = string;
+  *s++ = (x[NE - 1] & 0x8000) ? '-' : ' ';
+
+/* Significand without its trailing zero words; value = S * 2^b.  */
+  for (lo = 0; lo < NE - 1 && x[lo] == 0; lo++)
+    ;
+  if (lo == NE - 1)
+    {
+      expon = 0;
+      ndigs = ndigits > NDEC ? NDEC : ndigits;
+      *s++ = '0';
+      *s++ = '.';
+      for (k = 0; k < ndigs; k++)
+	*s++ = '0';
+      goto doexp;
+    }
+  b = exp - EXONE - (16 * (NE - 1) - 1) + 16 * lo;
+  ns = 0;
+  for (i = lo; i < NE - 1; i += 2)
+    sw[ns++] = x[i] | (i + 1 < NE - 1 ? (uint32_t) x[i + 1] << 16 : 0);
+  while (sw[ns - 1] == 0)
+    ns--;
+
+/* Estimate the decimal exponent from the binary one; it is this or one
+   more.  */
+  for (k = 31; (sw[ns - 1] >> k) == 0; k--)
+    ;
+  e2 = 32 * (ns - 1) + k + b;
+  if (e2 >= 0)
+    est = (int) (((uint64_t) e2 * 1292913986) >> 32);
+  else
+    est = -(int) ((((uint64_t) -e2 * 1292913986) + 0xffffffff) >> 32);
+
+/* Scale so that the integer part has the digits etoasc would give;
+   one more is folded into the rounding below.  */
+  if (outformat == 3)
+    {
+      j = ndigits;
+      if (ndigits + est > NDEC)
+	j = NDEC - est;
+      limit = NDEC + 1;
+    }
+  else
+    {
+      if (ndigits < 0)
+	return -1;
+      j = ndigits - est;
+      limit = ndigits + 1;
+    }
+
+  n = -1;
+  if (j > 150 || (j < 0 && e2 > 512))
+    n = apx_scale (sw, ns, b, j, qw, &state);
+  if (n < 0 && j >= 0)
+    {
+      /* S * 2^b * 10^j exactly, then split at bit -b into quotient and
+	 remainder.  Here S * 2^b < 10^(NDEC + 2), so a positive b is
+	 small.  */
+      if (b > 32 * 5)
+	return -1;
+      for (nb = 0; nb < ns; nb++)
+	big[nb] = sw[nb];
+      for (k = 0; k < b; k += 31)
+	nb = bin_mul (big, nb, (uint32_t) 1 << (b - k < 31 ? b - k : 31));
+      for (k = j; k > 0; k -= 9)
+	{
+	  if (nb >= NBIG - 1)
+	    return -1;
+	  nb = bin_mul (big, nb, k >= 9 ? BIGBASE : pow10_9[k]);
+	}
+      b = b < 0 ? -b : 0;
+      state = 0;
+      if (b > 0)
+	{
+	  k = (b - 1) / 32;
+	  if (k < nb)
+	    {
+	      if ((big[k] >> (b - 1) % 32) & 1)
+		state = 2;
+	      if (big[k] & (((uint32_t) 1 << (b - 1) % 32) - 1))
+		state |= 1;
+	    }
+	  for (i = 0; i < k && i < nb; i++)
+	    if (big[i] != 0)
+	      state |= 1;
+	}
+      n = 0;
+      for (i = b / 32; i < nb; i++)
+	{
+	  if (n == 8)
+	    return -1;
+	  qw[n++] = bits32 (big, nb, 32 * i + b % 32);
+	}
+    }
+  if (n >= 0)
+    {
+      nd = bin_to_dec (qw, n, big);
+      n = dec_len (big, nd);
+      if (n > limit + 1)
+	return -1;
+      for (i = 0; i < n; i++)
+	digs[i] = '0' + dec_digit (big, n - 1 - i);
+    }
+  else
+    {
+      /* Integer part of S * 2^b in base 10^9, then cut off -j digits.  */
+      state = 0;
+      if (b >= 0)
+	{
+	  nd = bin_to_dec (sw, ns, big);
+	  for (k = b; k > 0; k -= 29)
+	    {
+	      if (nd >= NBIG - 1)
+		return -1;
+	      nd = dec_mul (big, nd, (uint32_t) 1 << (k > 29 ? 29 : k));
+	    }
+	}
+      else
+	{
+	  b = -b;
+	  for (i = 0; i < ns; i++)
+	    {
+	      qw[i] = bits32 (sw, ns, 32 * i + b);
+	      if (i < b / 32 && sw[i] != 0)
+		state = 1;
+	    }
+	  if (b / 32 < ns && (sw[b / 32] & (((uint32_t) 1 << b % 32) - 1)))
+	    state = 1;
+	  nd = bin_to_dec (qw, ns, big);
+	}
+      k = dec_len (big, nd);
+      n = k + j;
+      if (n <= 0 || n > limit + 1)
+	return -1;
+      for (i = 0; i < n; i++)
+	digs[i] = '0' + dec_digit (big, k - 1 - i);
+      i = dec_digit (big, -j - 1);
+      if (dec_sticky (big, -j - 1))
+	state = 1;
+      if (i > 5 || (i == 5 && state))
+	state = 3;
+      else if (i == 5)
+	state = 2;
+      else if (i != 0)
+	state = 1;
+    }
+
+  if (outformat != 3 && n < limit)
+    return -1;
+  expon = n - 1 - j;
+  if (n > limit)
+    {
+      n--;
+      i = digs[n] - '0';
+      if (i > 5 || (i == 5 && state))
+	state = 3;
+      else if (i == 5)
+	state = 2;
+      else if (i != 0 || state)
+	state = 1;
+    }
+
+/* Round to nearest, ties to even, and propagate carry-outs.  */
+  if (state == 3 || (state == 2 && n > 0 && (digs[n - 1] & 1)))
+    {
+      for (i = n - 1; i >= 0 && digs[i] == '9'; i--)
+	digs[i] = '0';
+      if (i >= 0)
+	digs[i]++;
+      else
+	{
+	  digs[0] = '1';
+	  if (n == 0)
+	    n = 1;
+	  expon += 1;
+	}
+    }
+  if (n == 0)
+    {
+      /* Rounded to nothing; _ldtoa_r flushes this to zero.  */
+      digs[0] = '0';
+      n = 1;
+      expon = -j - 1;
+    }
+
+  *s++ = digs[0];
+  *s++ = '.';
+  for (i = 1; i < n; i++)
+    *s++ = digs[i];
+doexp:
+  sprintf (s, "E%d", expon);
+  ldp->outexpon = expon;
+  return 0;
+}
+
+#endif /* LDBL_MANT_DIG == 64 || LDBL_MANT_DIG == 113 */
+
 /* This routine will not return more than NDEC+1 digits. */
 
 char *
@@ -2834,7 +3306,10 @@ _ldtoa_r (struct _reent *ptr, long double d, int mode, int ndigits,
   if (ndigits > NDEC)
     ndigits = NDEC;
 
-  etoasc (e, outbuf, ndigits, mode, ldp);
+#if LDBL_MANT_DIG == 64 || LDBL_MANT_DIG == 113
+  if (etoasc_exact (e, outbuf, ndigits, mode, ldp) != 0)
+#endif
+    etoasc (e, outbuf, ndigits, mode, ldp);
   s = outbuf;
   if (eisinf (e) || eisnan (e))
     {
@@ -60,4 +60,7 @@ extern wchar_t __cp_conv[][0x80];
 int __cp_val_index (int);
 int __cp_index (const char *);
 
+/* Called by a port's fork() in the child, see arc4random.h.  */
+void _arc4random_fork_child (void);
+
 #endif
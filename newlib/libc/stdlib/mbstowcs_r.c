@@ -13,12 +13,15 @@ _DEFUN (_mbstowcs_r, (reent, pwcs, s, n, state),
   size_t ret = 0;
   char *t = (char *)s;
   int bytes;
+  struct __locale_t *locale = __get_current_locale ();
+  mbtowc_p l_mbtowc = locale->mbtowc;
+  int mb_cur_max = __locale_mb_cur_max_l (locale);
 
   if (!pwcs)
     n = (size_t) 1; /* Value doesn't matter as long as it's not 0. */
   while (n > 0)
     {
-      bytes = __MBTOWC (r, pwcs, t, MB_CUR_MAX, state);
+      bytes = l_mbtowc (r, pwcs, t, mb_cur_max, state);
       if (bytes < 0)
 	{
 	  state->__count = 0;
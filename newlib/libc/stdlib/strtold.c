@@ -58,6 +58,13 @@ __flt_rounds(void)
 #define FLT_ROUNDS 0
 #endif
 
+/* gdtoa's conversion for the long double format in use.  */
+#if LDBL_MANT_DIG == 113
+#define _strtold_fmt_l _strtorQ_l
+#else
+#define _strtold_fmt_l _strtorx_l
+#endif
+
 long double
 _strtold_r (struct _reent *ptr, const char *__restrict s00,
 	    char **__restrict se)
@@ -68,7 +75,7 @@ _strtold_r (struct _reent *ptr, const char *__restrict s00,
 #else
   long double result;
 
-  _strtorx_l (ptr, s00, se, FLT_ROUNDS, &result, __get_current_locale ());
+  _strtold_fmt_l (ptr, s00, se, FLT_ROUNDS, &result, __get_current_locale ());
   return result;
 #endif
 }
@@ -82,7 +89,7 @@ strtold_l (const char *__restrict s00, char **__restrict se, locale_t loc)
 #else
   long double result;
 
-  _strtorx_l (_REENT, s00, se, FLT_ROUNDS, &result, loc);
+  _strtold_fmt_l (_REENT, s00, se, FLT_ROUNDS, &result, loc);
   return result;
 #endif
 }
@@ -96,7 +103,8 @@ strtold (const char *__restrict s00, char **__restrict se)
 #else
   long double result;
 
-  _strtorx_l (_REENT, s00, se, FLT_ROUNDS, &result, __get_current_locale ());
+  _strtold_fmt_l (_REENT, s00, se, FLT_ROUNDS, &result,
+		  __get_current_locale ());
   return result;
 #endif
 }
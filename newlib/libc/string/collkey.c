@@ -0,0 +1,682 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/*
+ * Multi-level collation for strcoll, strxfrm, wcscoll and wcsxfrm in
+ * locales other than "C" and "POSIX".
+ *
+ * Each character maps to up to COLL_MAXELEM collation elements holding a
+ * primary (base letter), secondary (accent) and tertiary (case, variant)
+ * weight, following the layout of the Unicode Collation Algorithm's
+ * default table (DUCET).  Only a subset is tabulated: the whitespace,
+ * punctuation and symbols of Latin-1 and General Punctuation, digits,
+ * Latin-1 and Latin Extended-A, basic Greek and Cyrillic.  Precomposed
+ * letters expand to their base letter followed by the weight of their
+ * accents, so they collate like their canonical decomposition.  Every
+ * other character gets an implicit weight in code point order after all
+ * of these.  Control characters, the soft hyphen and unknown combining
+ * marks are ignorable.
+ *
+ * Strings are compared by primary weights first, then secondary, then
+ * tertiary, and strings that are still equal are ordered by strcmp or
+ * wcscmp.  The sort key built by strxfrm and wcsxfrm lists the weights
+ * level by level, separated by a unit of 1, so that comparing two keys
+ * with strcmp (or memcmp, or wcscmp) gives the same result as strcoll
+ * on the original strings.
+ *
+ * Multibyte strings are decoded with the LC_CTYPE conversion function of
+ * the locale.  Bytes that do not decode sort like code points past the
+ * end of Unicode.
+ */
+
+#include <_ansi.h>
+#include <reent.h>
+#include <string.h>
+#include <stdlib.h>
+#include <wchar.h>
+#include <limits.h>
+#include "local.h"
+
+#ifdef _MB_CAPABLE
+
+#define COLL_MAXELEM	3
+
+/* Primary weights. */
+#define P_SYMBOL	0x0100	/* + rank in coll_symbols */
+#define P_DIGIT		0x0200
+#define P_LATIN		0x0300	/* + 2 * letter, + 1 for letters of their own */
+#define P_GREEK		0x0400
+#define P_CYRILLIC	0x0500	/* + rank in coll_cyrillic */
+#define P_IMPLICIT	0xf000	/* + (c >> 15), then a second element */
+
+/* Secondary weights.  Known accents sort in the order of coll_marks. */
+#define S_BASE		2
+#define S_MARK		3
+#define S_OTHER		0x20	/* + (c - 0x300) for other combining marks */
+
+/* Tertiary weights. */
+#define T_LOWER		2
+#define T_LVARIANT	4
+#define T_UPPER		8
+#define T_UVARIANT	10
+
+#define LATIN(l)	(P_LATIN + 2 * ((l) - 'a'))
+
+struct coll_elem
+{
+  unsigned short pri;
+  unsigned char sec;
+  unsigned char ter;
+};
+
+/* Accents by increasing secondary weight, as the characters used for them
+   in the decomposition tables, and as combining marks.  '/' is a stroke
+   through the letter. */
+static _CONST char coll_marks[] = "'`u^vo:\"~.,;-/";
+static _CONST unsigned short coll_combining[] =
+{
+  0x0301, 0x0300, 0x0306, 0x0302, 0x030c, 0x030a, 0x0308,
+  0x030b, 0x0303, 0x0307, 0x0327, 0x0328, 0x0304, 0x0338
+};
+
+/* Whitespace, punctuation and symbols, sorted by code point, with their
+   rank in collation order and their tertiary weight. */
+static _CONST struct
+{
+  unsigned short c;
+  unsigned char rank;
+  unsigned char ter;
+} coll_symbols[] =
+{
+  { 0x0009,  1, 2 },	/* CHARACTER TABULATION */
+  { 0x000a,  2, 2 },	/* LINE FEED */
+  { 0x000b,  3, 2 },	/* LINE TABULATION */
+  { 0x000c,  4, 2 },	/* FORM FEED */
+  { 0x000d,  5, 2 },	/* CARRIAGE RETURN */
+  { 0x0020,  7, 2 },	/* SPACE */
+  { 0x0021, 18, 2 },	/* EXCLAMATION MARK */
+  { 0x0022, 31, 2 },	/* QUOTATION MARK */
+  { 0x0023, 50, 2 },	/* NUMBER SIGN */
+  { 0x0024, 78, 2 },	/* DOLLAR SIGN */
+  { 0x0025, 51, 2 },	/* PERCENT SIGN */
+  { 0x0026, 49, 2 },	/* AMPERSAND */
+  { 0x0027, 25, 2 },	/* APOSTROPHE */
+  { 0x0028, 37, 2 },	/* LEFT PARENTHESIS */
+  { 0x0029, 38, 2 },	/* RIGHT PARENTHESIS */
+  { 0x002a, 46, 2 },	/* ASTERISK */
+  { 0x002b, 65, 2 },	/* PLUS SIGN */
+  { 0x002c, 15, 2 },	/* COMMA */
+  { 0x002d,  9, 2 },	/* HYPHEN-MINUS */
+  { 0x002e, 22, 2 },	/* FULL STOP */
+  { 0x002f, 47, 2 },	/* SOLIDUS */
+  { 0x003a, 17, 2 },	/* COLON */
+  { 0x003b, 16, 2 },	/* SEMICOLON */
+  { 0x003c, 69, 2 },	/* LESS-THAN SIGN */
+  { 0x003d, 70, 2 },	/* EQUALS SIGN */
+  { 0x003e, 71, 2 },	/* GREATER-THAN SIGN */
+  { 0x003f, 20, 2 },	/* QUESTION MARK */
+  { 0x0040, 45, 2 },	/* COMMERCIAL AT */
+  { 0x005b, 39, 2 },	/* LEFT SQUARE BRACKET */
+  { 0x005c, 48, 2 },	/* REVERSE SOLIDUS */
+  { 0x005d, 40, 2 },	/* RIGHT SQUARE BRACKET */
+  { 0x005e, 58, 2 },	/* CIRCUMFLEX ACCENT */
+  { 0x005f,  8, 2 },	/* LOW LINE */
+  { 0x0060, 56, 2 },	/* GRAVE ACCENT */
+  { 0x007b, 41, 2 },	/* LEFT CURLY BRACKET */
+  { 0x007c, 73, 2 },	/* VERTICAL LINE */
+  { 0x007d, 42, 2 },	/* RIGHT CURLY BRACKET */
+  { 0x007e, 75, 2 },	/* TILDE */
+  { 0x0085,  6, 2 },	/* NEXT LINE */
+  { 0x00a0,  7, 4 },	/* NO-BREAK SPACE */
+  { 0x00a1, 19, 2 },	/* INVERTED EXCLAMATION MARK */
+  { 0x00a2, 77, 2 },	/* CENT SIGN */
+  { 0x00a3, 79, 2 },	/* POUND SIGN */
+  { 0x00a4, 76, 2 },	/* CURRENCY SIGN */
+  { 0x00a5, 80, 2 },	/* YEN SIGN */
+  { 0x00a6, 74, 2 },	/* BROKEN BAR */
+  { 0x00a7, 43, 2 },	/* SECTION SIGN */
+  { 0x00a8, 59, 2 },	/* DIAERESIS */
+  { 0x00a9, 63, 2 },	/* COPYRIGHT SIGN */
+  { 0x00ab, 35, 2 },	/* LEFT-POINTING DOUBLE ANGLE QUOTATION MARK */
+  { 0x00ac, 72, 2 },	/* NOT SIGN */
+  { 0x00ae, 64, 2 },	/* REGISTERED SIGN */
+  { 0x00af, 61, 2 },	/* MACRON */
+  { 0x00b0, 62, 2 },	/* DEGREE SIGN */
+  { 0x00b1, 66, 2 },	/* PLUS-MINUS SIGN */
+  { 0x00b4, 57, 2 },	/* ACUTE ACCENT */
+  { 0x00b6, 44, 2 },	/* PILCROW SIGN */
+  { 0x00b7, 24, 2 },	/* MIDDLE DOT */
+  { 0x00b8, 60, 2 },	/* CEDILLA */
+  { 0x00bb, 36, 2 },	/* RIGHT-POINTING DOUBLE ANGLE QUOTATION MARK */
+  { 0x00bf, 21, 2 },	/* INVERTED QUESTION MARK */
+  { 0x00d7, 68, 2 },	/* MULTIPLICATION SIGN */
+  { 0x00f7, 67, 2 },	/* DIVISION SIGN */
+  { 0x2002,  7, 4 },	/* EN SPACE */
+  { 0x2003,  7, 4 },	/* EM SPACE */
+  { 0x2009,  7, 4 },	/* THIN SPACE */
+  { 0x2010, 10, 2 },	/* HYPHEN */
+  { 0x2011, 10, 4 },	/* NON-BREAKING HYPHEN */
+  { 0x2012, 11, 2 },	/* FIGURE DASH */
+  { 0x2013, 12, 2 },	/* EN DASH */
+  { 0x2014, 13, 2 },	/* EM DASH */
+  { 0x2015, 14, 2 },	/* HORIZONTAL BAR */
+  { 0x2018, 26, 2 },	/* LEFT SINGLE QUOTATION MARK */
+  { 0x2019, 27, 2 },	/* RIGHT SINGLE QUOTATION MARK */
+  { 0x201a, 28, 2 },	/* SINGLE LOW-9 QUOTATION MARK */
+  { 0x201c, 32, 2 },	/* LEFT DOUBLE QUOTATION MARK */
+  { 0x201d, 33, 2 },	/* RIGHT DOUBLE QUOTATION MARK */
+  { 0x201e, 34, 2 },	/* DOUBLE LOW-9 QUOTATION MARK */
+  { 0x2020, 53, 2 },	/* DAGGER */
+  { 0x2021, 54, 2 },	/* DOUBLE DAGGER */
+  { 0x2022, 55, 2 },	/* BULLET */
+  { 0x2026, 23, 2 },	/* HORIZONTAL ELLIPSIS */
+  { 0x2028,  2, 4 },	/* LINE SEPARATOR */
+  { 0x2029,  2, 4 },	/* PARAGRAPH SEPARATOR */
+  { 0x2030, 52, 2 },	/* PER MILLE SIGN */
+  { 0x2039, 29, 2 },	/* SINGLE LEFT-POINTING ANGLE QUOTATION MARK */
+  { 0x203a, 30, 2 },	/* SINGLE RIGHT-POINTING ANGLE QUOTATION MARK */
+  { 0x20ac, 81, 2 },	/* EURO SIGN */
+};
+
+#define NSYMBOLS	(sizeof (coll_symbols) / sizeof (coll_symbols[0]))
+#define NCOMBINING \
+  ((int) (sizeof (coll_combining) / sizeof (coll_combining[0])))
+
+/* Decompositions of U+00C0 to U+017F: base letter and accent, or blanks
+   for the letters handled in coll_elems. */
+static _CONST char coll_latin[] =
+  "A`A'A^A~A:Ao  C,E`E'E^E:I`I'I^I:"	/* U+00C0 */
+  "  N~O`O'O^O~O:  O/U`U'U^U:Y'    "	/* U+00D0 */
+  "a`a'a^a~a:ao  c,e`e'e^e:i`i'i^i:"	/* U+00E0 */
+  "  n~o`o'o^o~o:  o/u`u'u^u:y'  y:"	/* U+00F0 */
+  "A-a-AuauA;a;C'c'C^c^C.c.CvcvDvdv"	/* U+0100 */
+  "D/d/E-e-EueuE.e.E;e;EvevG^g^Gugu"	/* U+0110 */
+  "G.g.G,g,H^h^H/h/I~i~I-i-IuiuI;i;"	/* U+0120 */
+  "I.      J^j^K,k,  L'l'L,l,Lvlv  "	/* U+0130 */
+  "  L/l/N'n'N,n,Nvnv      O-o-Ouou"	/* U+0140 */
+  "O\"o\"    R'r'R,r,RvrvS's'S^s^S,s,"	/* U+0150 */
+  "SvsvT,t,TvtvT/t/U~u~U-u-UuuuUouo"	/* U+0160 */
+  "U\"u\"U;u;W^w^Y^y^Y:Z'z'Z.z.Zvzv  ";	/* U+0170 */
+
+/* Decompositions of precomposed Greek and Cyrillic letters. */
+static _CONST struct
+{
+  unsigned short c;
+  unsigned short base;
+  char marks[3];
+} coll_decomp[] =
+{
+  { 0x0386, 0x0391, "'" }, { 0x0388, 0x0395, "'" }, { 0x0389, 0x0397, "'" },
+  { 0x038a, 0x0399, "'" }, { 0x038c, 0x039f, "'" }, { 0x038e, 0x03a5, "'" },
+  { 0x038f, 0x03a9, "'" }, { 0x0390, 0x03b9, ":'" }, { 0x03aa, 0x0399, ":" },
+  { 0x03ab, 0x03a5, ":" }, { 0x03ac, 0x03b1, "'" }, { 0x03ad, 0x03b5, "'" },
+  { 0x03ae, 0x03b7, "'" }, { 0x03af, 0x03b9, "'" }, { 0x03b0, 0x03c5, ":'" },
+  { 0x03ca, 0x03b9, ":" }, { 0x03cb, 0x03c5, ":" }, { 0x03cc, 0x03bf, "'" },
+  { 0x03cd, 0x03c5, "'" }, { 0x03ce, 0x03c9, "'" },
+  { 0x0400, 0x0415, "`" }, { 0x0401, 0x0415, ":" }, { 0x0403, 0x0413, "'" },
+  { 0x0407, 0x0406, ":" }, { 0x040c, 0x041a, "'" }, { 0x040d, 0x0418, "`" },
+  { 0x040e, 0x0423, "u" }, { 0x0419, 0x0418, "u" }, { 0x0439, 0x0438, "u" },
+  { 0x0450, 0x0435, "`" }, { 0x0451, 0x0435, ":" }, { 0x0453, 0x0433, "'" },
+  { 0x0457, 0x0456, ":" }, { 0x045c, 0x043a, "'" }, { 0x045d, 0x0438, "`" },
+  { 0x045e, 0x0443, "u" },
+};
+
+#define NDECOMP		(sizeof (coll_decomp) / sizeof (coll_decomp[0]))
+
+/* Rank of the lower case Cyrillic letters U+0430 to U+045F in collation
+   order, or 0 for letters in coll_decomp.  U+0491 GHE WITH UPTURN has
+   rank 5. */
+static _CONST unsigned char coll_cyrillic[] =
+{
+   1,  2,  3,  4,  6,  8, 10, 11, 13,  0, 16, 17, 19, 20, 22, 23,	/* U+0430 */
+  24, 25, 26, 28, 29, 30, 31, 32, 34, 35, 36, 37, 38, 39, 40, 41,	/* U+0440 */
+   0,  0,  7,  0,  9, 12, 14,  0, 15, 18, 21, 27,  0,  0,  0, 33,	/* U+0450 */
+};
+
+#define SET(e, p, s, t) \
+  ((e)->pri = (p), (e)->sec = (s), (e)->ter = (t))
+
+static int
+_DEFUN (coll_symbol, (c, ce),
+	wint_t c _AND
+	struct coll_elem *ce)
+{
+  size_t lo = 0, hi = NSYMBOLS, mid;
+
+  while (lo < hi)
+    {
+      mid = (lo + hi) / 2;
+      if (coll_symbols[mid].c == c)
+	{
+	  SET (ce, P_SYMBOL + coll_symbols[mid].rank, S_BASE,
+	       coll_symbols[mid].ter);
+	  return 1;
+	}
+      if (coll_symbols[mid].c < c)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  return 0;
+}
+
+static int coll_elems (wint_t, struct coll_elem *);
+
+/* Store the elements of BASE followed by one secondary element for each
+   accent in MARKS. */
+static int
+_DEFUN (coll_compose, (base, marks, ce),
+	wint_t base _AND
+	_CONST char *marks _AND
+	struct coll_elem *ce)
+{
+  int n = coll_elems (base, ce);
+
+  for (; *marks; marks++, n++)
+    SET (&ce[n], 0, S_MARK + (strchr (coll_marks, *marks) - coll_marks),
+	 T_LOWER);
+  return n;
+}
+
+/* Store the collation elements of C in CE and return how many there are. */
+static int
+_DEFUN (coll_elems, (c, ce),
+	wint_t c _AND
+	struct coll_elem *ce)
+{
+  size_t lo, hi, mid;
+  int i, t;
+
+  if (c >= 'a' && c <= 'z')
+    {
+      SET (ce, LATIN (c), S_BASE, T_LOWER);
+      return 1;
+    }
+  if (c >= 'A' && c <= 'Z')
+    {
+      SET (ce, LATIN (c - 'A' + 'a'), S_BASE, T_UPPER);
+      return 1;
+    }
+  if (c >= '0' && c <= '9')
+    {
+      SET (ce, P_DIGIT + c - '0', S_BASE, T_LOWER);
+      return 1;
+    }
+  if (c < 0x180)
+    {
+      if (c >= 0xc0 && coll_latin[2 * (c - 0xc0)] != ' ')
+	{
+	  char mark[2];
+
+	  mark[0] = coll_latin[2 * (c - 0xc0) + 1];
+	  mark[1] = '\0';
+	  return coll_compose (coll_latin[2 * (c - 0xc0)], mark, ce);
+	}
+      switch (c)
+	{
+	case 0xaa:		/* FEMININE ORDINAL INDICATOR */
+	case 0xba:		/* MASCULINE ORDINAL INDICATOR */
+	  SET (ce, LATIN (c == 0xaa ? 'a' : 'o'), S_BASE, T_LVARIANT);
+	  return 1;
+	case 0xb2:		/* SUPERSCRIPT TWO */
+	case 0xb3:		/* SUPERSCRIPT THREE */
+	case 0xb9:		/* SUPERSCRIPT ONE */
+	  SET (ce, P_DIGIT + (c == 0xb9 ? 1 : c - 0xb0), S_BASE, T_LVARIANT);
+	  return 1;
+	case 0xb5:		/* MICRO SIGN */
+	  SET (ce, P_GREEK + 0x3bc - 0x3b1, S_BASE, T_LVARIANT);
+	  return 1;
+	case 0xbc:		/* VULGAR FRACTION ONE QUARTER */
+	case 0xbd:		/* VULGAR FRACTION ONE HALF */
+	case 0xbe:		/* VULGAR FRACTION THREE QUARTERS */
+	  SET (&ce[0], P_DIGIT + (c == 0xbe ? 3 : 1), S_BASE, T_LVARIANT);
+	  coll_symbol ('/', &ce[1]);
+	  ce[1].ter = T_LVARIANT;
+	  SET (&ce[2], P_DIGIT + (c == 0xbd ? 2 : 4), S_BASE, T_LVARIANT);
+	  return 3;
+	case 0xc6:		/* AE */
+	case 0xe6:
+	  SET (ce, LATIN ('a') + 1, S_BASE, c == 0xc6 ? T_UPPER : T_LOWER);
+	  return 1;
+	case 0xd0:		/* ETH */
+	case 0xf0:
+	  SET (ce, LATIN ('d') + 1, S_BASE, c == 0xd0 ? T_UPPER : T_LOWER);
+	  return 1;
+	case 0xde:		/* THORN */
+	case 0xfe:
+	  SET (ce, LATIN ('z') + 1, S_BASE, c == 0xde ? T_UPPER : T_LOWER);
+	  return 1;
+	case 0xdf:		/* SHARP S */
+	  SET (&ce[0], LATIN ('s'), S_BASE, T_LVARIANT);
+	  SET (&ce[1], LATIN ('s'), S_BASE, T_LVARIANT);
+	  return 2;
+	case 0x131:		/* DOTLESS I */
+	  SET (ce, LATIN ('i') + 1, S_BASE, T_LOWER);
+	  return 1;
+	case 0x132:		/* IJ */
+	case 0x133:
+	  t = c == 0x132 ? T_UVARIANT : T_LVARIANT;
+	  SET (&ce[0], LATIN ('i'), S_BASE, t);
+	  SET (&ce[1], LATIN ('j'), S_BASE, t);
+	  return 2;
+	case 0x138:		/* KRA */
+	  SET (ce, LATIN ('q') + 1, S_BASE, T_LOWER);
+	  return 1;
+	case 0x13f:		/* L WITH MIDDLE DOT */
+	case 0x140:
+	  SET (&ce[0], LATIN ('l'), S_BASE,
+	       c == 0x13f ? T_UVARIANT : T_LVARIANT);
+	  coll_symbol (0xb7, &ce[1]);
+	  ce[1].ter = T_LVARIANT;
+	  return 2;
+	case 0x149:		/* N PRECEDED BY APOSTROPHE */
+	  coll_symbol (0x2019, &ce[0]);
+	  ce[0].ter = T_LVARIANT;
+	  SET (&ce[1], LATIN ('n'), S_BASE, T_LVARIANT);
+	  return 2;
+	case 0x14a:		/* ENG */
+	case 0x14b:
+	  SET (ce, LATIN ('n') + 1, S_BASE, c == 0x14a ? T_UPPER : T_LOWER);
+	  return 1;
+	case 0x152:		/* OE */
+	case 0x153:
+	  SET (ce, LATIN ('o') + 1, S_BASE, c == 0x152 ? T_UPPER : T_LOWER);
+	  return 1;
+	case 0x17f:		/* LONG S */
+	  SET (ce, LATIN ('s'), S_BASE, T_LVARIANT);
+	  return 1;
+	}
+      if (coll_symbol (c, ce))
+	return 1;
+      /* Other C0 and C1 controls and the soft hyphen are ignorable. */
+      if (c < 0x20 || (c >= 0x7f && c < 0xa0) || c == 0xad)
+	return 0;
+    }
+  else if (c >= 0x300 && c < 0x370)
+    {
+      for (i = 0; i < NCOMBINING; i++)
+	if (coll_combining[i] == c)
+	  break;
+      SET (ce, 0, i < NCOMBINING ? S_MARK + i : S_OTHER + (c - 0x300),
+	   T_LOWER);
+      return 1;
+    }
+  else if (c >= 0x386 && c < 0x492)
+    {
+      lo = 0;
+      hi = NDECOMP;
+      while (lo < hi)
+	{
+	  mid = (lo + hi) / 2;
+	  if (coll_decomp[mid].c == c)
+	    return coll_compose (coll_decomp[mid].base, coll_decomp[mid].marks,
+				 ce);
+	  if (coll_decomp[mid].c < c)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+      /* Greek, with final sigma a variant of sigma. */
+      t = T_LOWER;
+      if (c >= 0x391 && c <= 0x3a9 && c != 0x3a2)
+	{
+	  c += 0x20;
+	  t = T_UPPER;
+	}
+      if (c >= 0x3b1 && c <= 0x3c9)
+	{
+	  if (c == 0x3c2)
+	    {
+	      c = 0x3c3;
+	      t = T_LVARIANT;
+	    }
+	  SET (ce, P_GREEK + c - 0x3b1, S_BASE, t);
+	  return 1;
+	}
+      /* Cyrillic. */
+      if (c >= 0x400 && c < 0x430)
+	{
+	  c += c < 0x410 ? 0x50 : 0x20;
+	  t = T_UPPER;
+	}
+      if (c == 0x490 || c == 0x491)
+	{
+	  SET (ce, P_CYRILLIC + 5, S_BASE, c == 0x490 ? T_UPPER : T_LOWER);
+	  return 1;
+	}
+      if (c >= 0x430 && c < 0x460 && coll_cyrillic[c - 0x430] != 0)
+	{
+	  SET (ce, P_CYRILLIC + coll_cyrillic[c - 0x430], S_BASE, t);
+	  return 1;
+	}
+      if (t == T_UPPER)
+	c -= c < 0x450 ? 0x20 : 0x50;
+    }
+  else if (coll_symbol (c, ce))
+    return 1;
+
+  /* Implicit weight: the high bits of the code point as primary weight of
+     a first element, the low bits as primary weight of a second one. */
+  SET (&ce[0], P_IMPLICIT + (c >> 15), S_BASE, T_LOWER);
+  SET (&ce[1], 1 + (c & 0x7fff), 0, 0);
+  return 2;
+}
+
+/* A cursor over the collation elements of a string. */
+struct coll_iter
+{
+  _CONST char *s;		/* multibyte string, or NULL */
+  _CONST wchar_t *ws;		/* wide string */
+  struct __locale_t *locale;
+  mbstate_t state;
+  struct coll_elem ce[COLL_MAXELEM];
+  int i, n;
+};
+
+static void
+_DEFUN (coll_init, (it, s, ws, locale),
+	struct coll_iter *it _AND
+	_CONST char *s _AND
+	_CONST wchar_t *ws _AND
+	struct __locale_t *locale)
+{
+  it->s = s;
+  it->ws = ws;
+  it->locale = locale;
+  memset (&it->state, 0, sizeof it->state);
+  it->i = it->n = 0;
+}
+
+/* Return the next character of the string, or 0 at its end. */
+static wint_t
+_DEFUN (coll_getc, (it),
+	struct coll_iter *it)
+{
+  wchar_t wc;
+  int r;
+
+  if (it->s == NULL)
+    return *it->ws != L'\0' ? (wint_t) *it->ws++ : 0;
+  if (*it->s == '\0')
+    return 0;
+  r = it->locale->mbtowc (_REENT, &wc, it->s, MB_LEN_MAX, &it->state);
+  if (r <= 0)
+    {
+      memset (&it->state, 0, sizeof it->state);
+      return 0x110000 + (unsigned char) *it->s++;
+    }
+  it->s += r;
+  return (wint_t) wc;
+}
+
+#define WEIGHT(e, level) \
+  ((level) == 0 ? (e)->pri : (level) == 1 ? (e)->sec : (e)->ter)
+
+/* Return the weight at LEVEL of the next element that has one, or 0 at
+   the end of the string. */
+static int
+_DEFUN (coll_next, (it, level),
+	struct coll_iter *it _AND
+	int level)
+{
+  _CONST struct coll_elem *e;
+  wint_t c;
+
+  for (;;)
+    {
+      while (it->i < it->n)
+	{
+	  e = &it->ce[it->i++];
+	  if (WEIGHT (e, level) != 0)
+	    return WEIGHT (e, level);
+	}
+      if ((c = coll_getc (it)) == 0)
+	return 0;
+      it->n = coll_elems (c, it->ce);
+      it->i = 0;
+    }
+}
+
+static int
+_DEFUN (coll_compare, (a, b, wa, wb, locale),
+	_CONST char *a _AND
+	_CONST char *b _AND
+	_CONST wchar_t *wa _AND
+	_CONST wchar_t *wb _AND
+	struct __locale_t *locale)
+{
+  struct coll_iter ia, ib;
+  int level, x, y;
+
+  for (level = 0; level < 3; level++)
+    {
+      coll_init (&ia, a, wa, locale);
+      coll_init (&ib, b, wb, locale);
+      do
+	{
+	  x = coll_next (&ia, level);
+	  y = coll_next (&ib, level);
+	  if (x != y)
+	    return x - y;
+	}
+      while (x != 0);
+    }
+  return a != NULL ? strcmp (a, b) : wcscmp (wa, wb);
+}
+
+/* Store the sort key of A or WA in the N units at KEY, bytes if KEY is
+   not NULL and wide characters at WKEY otherwise, and return its length.
+   Primary weights take two units each, all others one, and no unit of
+   the weights is smaller than 2. */
+static size_t
+_DEFUN (coll_key, (key, wkey, n, a, wa, locale),
+	char *key _AND
+	wchar_t *wkey _AND
+	size_t n _AND
+	_CONST char *a _AND
+	_CONST wchar_t *wa _AND
+	struct __locale_t *locale)
+{
+  struct coll_iter it;
+  size_t len = 0;
+  int level, w;
+
+#define PUT(u) \
+  do { \
+    if (len < n) \
+      { \
+	if (key != NULL) \
+	  key[len] = (char) (u); \
+	else \
+	  wkey[len] = (wchar_t) (u); \
+      } \
+    len++; \
+  } while (0)
+
+  for (level = 0; level < 3; level++)
+    {
+      if (level > 0)
+	PUT (1);
+      coll_init (&it, a, wa, locale);
+      while ((w = coll_next (&it, level)) != 0)
+	{
+	  if (level == 0)
+	    {
+	      PUT (2 + w / 254);
+	      w = 2 + w % 254;
+	    }
+	  PUT (w);
+	}
+    }
+  /* Identical level, for strings that differ only in ignorables or in
+     characters with the same weights. */
+  PUT (1);
+  if (a != NULL)
+    for (; *a != '\0'; a++)
+      PUT ((unsigned char) *a);
+  else
+    for (; *wa != L'\0'; wa++)
+      PUT (*wa);
+  if (len < n)
+    {
+      if (key != NULL)
+	key[len] = '\0';
+      else
+	wkey[len] = L'\0';
+    }
+  return len;
+#undef PUT
+}
+
+int
+_DEFUN (__ucoll_enabled, (locale),
+	struct __locale_t *locale)
+{
+  _CONST char *name = locale->categories[LC_COLLATE];
+
+  if (name[0] == 'C' && (name[1] == '\0' || name[1] == '.'))
+    return 0;
+  return strcmp (name, "POSIX") != 0;
+}
+
+int
+_DEFUN (__ucoll_strcoll, (a, b, locale),
+	_CONST char *a _AND
+	_CONST char *b _AND
+	struct __locale_t *locale)
+{
+  return coll_compare (a, b, NULL, NULL, locale);
+}
+
+size_t
+_DEFUN (__ucoll_strxfrm, (s1, s2, n, locale),
+	char *s1 _AND
+	_CONST char *s2 _AND
+	size_t n _AND
+	struct __locale_t *locale)
+{
+  return coll_key (s1, NULL, n, s2, NULL, locale);
+}
+
+int
+_DEFUN (__ucoll_wcscoll, (a, b, locale),
+	_CONST wchar_t *a _AND
+	_CONST wchar_t *b _AND
+	struct __locale_t *locale)
+{
+  return coll_compare (NULL, NULL, a, b, locale);
+}
+
+size_t
+_DEFUN (__ucoll_wcsxfrm, (s1, s2, n, locale),
+	wchar_t *s1 _AND
+	_CONST wchar_t *s2 _AND
+	size_t n _AND
+	struct __locale_t *locale)
+{
+  return coll_key (NULL, s1, n, NULL, s2, locale);
+}
+
+#endif /* _MB_CAPABLE */
@@ -4,6 +4,16 @@
 /* internal function to compute width of wide char. */
 int _EXFUN (__wcwidth, (wint_t));
 
+/* Collation in locales other than "C" and "POSIX", see collkey.c. */
+int _EXFUN (__ucoll_enabled, (struct __locale_t *));
+int _EXFUN (__ucoll_strcoll, (const char *, const char *, struct __locale_t *));
+size_t _EXFUN (__ucoll_strxfrm, (char *, const char *, size_t,
+				 struct __locale_t *));
+int _EXFUN (__ucoll_wcscoll, (const wchar_t *, const wchar_t *,
+			      struct __locale_t *));
+size_t _EXFUN (__ucoll_wcsxfrm, (wchar_t *, const wchar_t *, size_t,
+				 struct __locale_t *));
+
 /*
    Taken from glibc:
    Add the compiler optimization to inhibit loop transformation to library
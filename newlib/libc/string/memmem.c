@@ -43,6 +43,7 @@ QUICKREF
 # define RETURN_TYPE void *
 # define AVAILABLE(h, h_l, j, n_l) ((j) <= (h_l) - (n_l))
 # include "str-two-way.h"
+# include "str-filter.h"
 #endif
 
 void *
@@ -83,6 +84,32 @@ _DEFUN (memmem, (haystack_start, haystack_len, needle_start, needle_len),
   if (haystack_len < needle_len)
     return NULL;
 
+#ifdef FILTER_VEC
+  /* Narrow the search to positions matching the needle's first and
+     last bytes, a vector at a time.  Two-Way takes over if too many
+     candidates fail verification.  */
+  if (needle_len >= 2 && needle_len <= FILTER_MAX_NEEDLE)
+    {
+      const unsigned char *found;
+      const unsigned char *resume;
+      size_t len = haystack_len;
+
+      found = filter_search (haystack, &len, 0, needle, needle_len,
+			     needle, needle + needle_len - 1, &resume);
+      if (found || !resume)
+	return (void *) found;
+      haystack_len -= resume - haystack;
+      if (haystack_len < needle_len)
+	return NULL;
+      haystack = resume;
+      if (needle_len < LONG_NEEDLE_THRESHOLD)
+	return two_way_short_needle (haystack, haystack_len,
+				     needle, needle_len);
+      return two_way_long_needle (haystack, haystack_len,
+				  needle, needle_len);
+    }
+#endif
+
   /* Use optimizations in memchr when possible, to reduce the search
      size of haystack using a linear algorithm with a smaller
      coefficient.  However, avoid memchr for long needles, since we
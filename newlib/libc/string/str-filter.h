@@ -0,0 +1,205 @@
+/* Vectorized candidate filter for substring search.
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+
+/* Before including this file, you need to include <string.h>.  You may
+   optionally define:
+     FILTER_CMP(p1, p2, l)	A macro that returns 0 iff the first L
+				bytes of P1 and P2 are equal.  Defaults
+				to memcmp.
+     FILTER_FOLD		Match each of the needle's first and
+				last bytes against two alternatives
+				(for case-insensitive searches).
+
+  If the target has a suitable vector unit, this file defines
+  FILTER_VEC and the function filter_search; otherwise it defines
+  nothing, and callers should use the Two-Way code directly.
+*/
+
+#include <stdint.h>
+
+/* The filter (see "SIMD-friendly algorithms for substring searching",
+   W. Mula) compares a vector of haystack bytes against the needle's
+   first byte and the vector NEEDLE_LEN - 1 bytes further on against
+   its last byte.  Only positions where both match are verified with a
+   full comparison.  Bitmasks returned by FILTER_MASK have FILTER_BITS
+   bits per byte.  */
+#if defined(__AVX2__)
+# include <immintrin.h>
+# define FILTER_VEC 32
+# define FILTER_BITS 1
+typedef __m256i filter_vec_t;
+# define FILTER_SPLAT(c) _mm256_set1_epi8 ((char) (c))
+# define FILTER_LOAD(p) _mm256_load_si256 ((const __m256i *) (p))
+# define FILTER_LOADU(p) _mm256_loadu_si256 ((const __m256i *) (p))
+# define FILTER_EQ(a, b) _mm256_cmpeq_epi8 ((a), (b))
+# define FILTER_AND(a, b) _mm256_and_si256 ((a), (b))
+# define FILTER_OR(a, b) _mm256_or_si256 ((a), (b))
+# define FILTER_MASK(v) \
+  ((unsigned long long) (unsigned int) _mm256_movemask_epi8 (v))
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+# define FILTER_VEC 16
+# define FILTER_BITS 1
+typedef __m128i filter_vec_t;
+# define FILTER_SPLAT(c) _mm_set1_epi8 ((char) (c))
+# define FILTER_LOAD(p) _mm_load_si128 ((const __m128i *) (p))
+# define FILTER_LOADU(p) _mm_loadu_si128 ((const __m128i *) (p))
+# define FILTER_EQ(a, b) _mm_cmpeq_epi8 ((a), (b))
+# define FILTER_AND(a, b) _mm_and_si128 ((a), (b))
+# define FILTER_OR(a, b) _mm_or_si128 ((a), (b))
+# define FILTER_MASK(v) \
+  ((unsigned long long) (unsigned int) _mm_movemask_epi8 (v))
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+# define FILTER_VEC 16
+# define FILTER_BITS 4
+typedef uint8x16_t filter_vec_t;
+# define FILTER_SPLAT(c) vdupq_n_u8 ((uint8_t) (c))
+# define FILTER_LOAD(p) vld1q_u8 ((const uint8_t *) (p))
+# define FILTER_LOADU(p) vld1q_u8 ((const uint8_t *) (p))
+# define FILTER_EQ(a, b) vceqq_u8 ((a), (b))
+# define FILTER_AND(a, b) vandq_u8 ((a), (b))
+# define FILTER_OR(a, b) vorrq_u8 ((a), (b))
+/* Narrow each 0x00/0xff byte to a nibble.  */
+# define FILTER_MASK(v) \
+  ((unsigned long long) vget_lane_u64 (vreinterpret_u64_u8 ( \
+     vshrn_n_u16 (vreinterpretq_u16_u8 (v), 4)), 0))
+#endif
+
+#ifdef FILTER_VEC
+
+#ifndef FILTER_CMP
+# define FILTER_CMP memcmp
+#endif
+
+/* Longest needle worth filtering; beyond this the shift table of
+   two_way_long_needle wins.  */
+#define FILTER_MAX_NEEDLE 256U
+
+/* Verification may cost this many needle bytes up front, plus
+   FILTER_RATIO bytes per haystack byte scanned.  Past that the caller
+   falls back to Two-Way, so the worst case stays linear.  */
+#define FILTER_SLACK 512
+#define FILTER_RATIO 2
+
+#define FILTER_LANE ((1ULL << FILTER_BITS) - 1)
+
+#ifdef FILTER_FOLD
+# define FILTER_MATCH(v, a, b) FILTER_OR (FILTER_EQ ((v), (a)), \
+					  FILTER_EQ ((v), (b)))
+# define FILTER_BYTE(c, x) ((c) == (x)[0] || (c) == (x)[1])
+#else
+# define FILTER_MATCH(v, a, b) FILTER_EQ ((v), (a))
+# define FILTER_BYTE(c, x) ((c) == (x)[0])
+#endif
+
+/* Search for NEEDLE, of length 2 <= NEEDLE_LEN <= FILTER_MAX_NEEDLE,
+   in HAYSTACK.  FIRST and LAST hold the byte values (two of each with
+   FILTER_FOLD) that may appear where the needle's first and last
+   bytes line up.
+
+   If NUL_TERM is zero, *HAYSTACK_LEN is the haystack length.
+   Otherwise the haystack ends at a NUL byte, and *HAYSTACK_LEN is a
+   count of bytes already known to precede it; it is raised as more of
+   the haystack is examined, using only aligned loads beyond that point
+   so nothing past the terminator's page is touched.
+
+   Returns the first match, or NULL.  If verification grows too
+   expensive, returns NULL with *RESUME set to the first position not
+   yet ruled out, for the caller to finish with Two-Way; otherwise sets
+   *RESUME to NULL.  */
+static const unsigned char *
+filter_search (const unsigned char *haystack, size_t *haystack_len,
+	       int nul_term, const unsigned char *needle, size_t needle_len,
+	       const unsigned char *first, const unsigned char *last,
+	       const unsigned char **resume)
+{
+  const unsigned char *h = haystack;
+  size_t h_l = *haystack_len;
+  int len_known = !nul_term;
+  size_t j = 0;
+  size_t need;
+  long budget = FILTER_SLACK;
+  unsigned long long mask;
+  unsigned int bit;
+  filter_vec_t f0 = FILTER_SPLAT (first[0]);
+  filter_vec_t l0 = FILTER_SPLAT (last[0]);
+#ifdef FILTER_FOLD
+  filter_vec_t f1 = FILTER_SPLAT (first[1]);
+  filter_vec_t l1 = FILTER_SPLAT (last[1]);
+#else
+# define f1 f0
+# define l1 l0
+#endif
+  filter_vec_t zero = FILTER_SPLAT (0);
+
+  *resume = NULL;
+  for (;;)
+    {
+      /* Both loads below must stay within the known haystack.  */
+      need = j + needle_len - 1 + FILTER_VEC;
+      if (h_l < need)
+	{
+	  const unsigned char *blk;
+
+	  if (len_known)
+	    break;
+	  blk = (const unsigned char *)
+	    ((uintptr_t) (h + h_l) & ~(uintptr_t) (FILTER_VEC - 1));
+	  mask = FILTER_MASK (FILTER_EQ (FILTER_LOAD (blk), zero));
+	  mask >>= (h + h_l - blk) * FILTER_BITS;
+	  if (mask)
+	    {
+	      h_l += __builtin_ctzll (mask) / FILTER_BITS;
+	      len_known = 1;
+	    }
+	  else
+	    h_l = blk + FILTER_VEC - h;
+	  continue;
+	}
+
+      mask = FILTER_MASK (FILTER_AND (FILTER_MATCH (FILTER_LOADU (h + j),
+						    f0, f1),
+				      FILTER_MATCH (FILTER_LOADU (h + j
+								  + needle_len
+								  - 1),
+						    l0, l1)));
+      budget += FILTER_RATIO * FILTER_VEC;
+      while (mask)
+	{
+	  bit = __builtin_ctzll (mask);
+	  if (FILTER_CMP (h + j + bit / FILTER_BITS + 1, needle + 1,
+			  needle_len - 2) == 0)
+	    return h + j + bit / FILTER_BITS;
+	  budget -= needle_len;
+	  if (budget < 0)
+	    {
+	      *resume = h + j + bit / FILTER_BITS + 1;
+	      *haystack_len = h_l;
+	      return NULL;
+	    }
+	  mask &= ~(FILTER_LANE << bit);
+	}
+      j += FILTER_VEC;
+    }
+
+  /* Fewer than FILTER_VEC positions remain.  */
+  for (; j + needle_len <= h_l; j++)
+    if (FILTER_BYTE (h[j], first)
+	&& FILTER_BYTE (h[j + needle_len - 1], last)
+	&& FILTER_CMP (h + j + 1, needle + 1, needle_len - 2) == 0)
+      return h + j;
+  *haystack_len = h_l;
+  return NULL;
+}
+
+#undef f1
+#undef l1
+
+#endif /* FILTER_VEC */
+
+#undef FILTER_CMP
+#undef FILTER_FOLD
@@ -90,6 +90,14 @@ QUICKREF
 #endif
 # define CMP_FUNC strncasecmp
 # include "str-two-way.h"
+# define FILTER_CMP(p1, p2, l) \
+  strncasecmp ((const char *) (p1), (const char *) (p2), (l))
+# define FILTER_FOLD
+# include "str-filter.h"
+# if defined (FILTER_VEC) && (defined (_MB_EXTENDED_CHARSETS_ISO) \
+			       || defined (_MB_EXTENDED_CHARSETS_WINDOWS))
+#  include "../locale/setlocale.h"
+# endif
 #endif
 
 /*
@@ -142,6 +150,38 @@ _DEFUN (strcasestr, (s, find),
   haystack = s + 1;
   haystack_len = needle_len - 1;
 
+#ifdef FILTER_VEC
+  /* The filter looks for each end of the needle in just two cases.
+     That holds unless single-byte locales can fold non-ASCII letters
+     onto ASCII ones (as tolower maps Latin-5 0xDD to 'i').  */
+  if (needle_len >= 2 && needle_len <= FILTER_MAX_NEEDLE
+#if defined (_MB_EXTENDED_CHARSETS_ISO) || defined (_MB_EXTENDED_CHARSETS_WINDOWS)
+      && (MB_CUR_MAX > 1 || !strcmp (__current_locale_charset (), "ASCII"))
+#endif
+      )
+    {
+      const unsigned char *start = (const unsigned char *) haystack;
+      const unsigned char *found;
+      const unsigned char *resume;
+      unsigned char first[2], last[2];
+
+      first[0] = tolower ((unsigned char) find[0]);
+      first[1] = toupper ((unsigned char) find[0]);
+      last[0] = tolower ((unsigned char) find[needle_len - 1]);
+      last[1] = toupper ((unsigned char) find[needle_len - 1]);
+      found = filter_search (start, &haystack_len, 1,
+			     (const unsigned char *) find, needle_len,
+			     first, last, &resume);
+      if (found || !resume)
+	return (char *) found;
+      haystack = (const char *) resume;
+      haystack_len -= resume - start;
+      /* AVAILABLE assumes no more than NEEDLE_LEN bytes are known.  */
+      if (haystack_len > needle_len)
+        haystack_len = needle_len;
+    }
+#endif
+
   /* Perform the search.  */
   if (needle_len < LONG_NEEDLE_THRESHOLD)
     return two_way_short_needle ((const unsigned char *) haystack,
@@ -20,8 +20,12 @@ DESCRIPTION
 	the string pointed to by <[strb]>, using an interpretation
 	appropriate to the current <<LC_COLLATE>> state.
 
-	(NOT Cygwin:) The current implementation of <<strcoll>> simply
-	uses <<strcmp>> and does not support any language-specific sorting.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<strcoll>> is the same
+	as <<strcmp>>.  In other locales it compares base letters first,
+	then accents, then case, in the default order of the Unicode
+	Collation Algorithm for Latin, Greek and Cyrillic letters, digits
+	and common punctuation, and orders other characters by code point.
+	Strings that are still equal are ordered by <<strcmp>>.
 
 RETURNS
 	If the first string is greater than the second string,
@@ -40,6 +44,7 @@ QUICKREF
 */
 
 #include <string.h>
+#include "local.h"
 
 int
 _DEFUN (strcoll, (a, b),
@@ -47,5 +52,11 @@ _DEFUN (strcoll, (a, b),
 	_CONST char *b)
 
 {
+#ifdef _MB_CAPABLE
+  struct __locale_t *locale = __get_current_locale ();
+
+  if (__ucoll_enabled (locale))
+    return __ucoll_strcoll (a, b, locale);
+#endif
   return strcmp (a, b);
 }
@@ -15,8 +15,12 @@ DESCRIPTION
 	the string pointed to by <[strb]>, using an interpretation
 	appropriate to the current <<LC_COLLATE>> state.
 
-	(NOT Cygwin:) The current implementation of <<strcoll_l>> simply
-	uses <<strcmp>> and does not support any language-specific sorting.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<strcoll_l>> is the same
+	as <<strcmp>>.  In other locales it compares base letters first,
+	then accents, then case, in the default order of the Unicode
+	Collation Algorithm for Latin, Greek and Cyrillic letters, digits
+	and common punctuation, and orders other characters by code point.
+	Strings that are still equal are ordered by <<strcmp>>.
 
 	If <[locale]> is LC_GLOBAL_LOCALE or not a valid locale object, the
 	behaviour is undefined.
@@ -38,9 +42,14 @@ QUICKREF
 */
 
 #include <string.h>
+#include "local.h"
 
 int
 strcoll_l (const char *a, const char *b, struct __locale_t *locale)
 {
+#ifdef _MB_CAPABLE
+  if (__ucoll_enabled (locale))
+    return __ucoll_strcoll (a, b, locale);
+#endif
   return strcmp (a, b);
 }
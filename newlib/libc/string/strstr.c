@@ -42,6 +42,7 @@ QUICKREF
   (!memchr ((h) + (h_l), '\0', (j) + (n_l) - (h_l))	\
    && ((h_l) = (j) + (n_l)))
 # include "str-two-way.h"
+# include "str-filter.h"
 #endif
 
 char *
@@ -101,15 +102,45 @@ _DEFUN (strstr, (searchee, lookfor),
   if (ok)
     return (char *) searchee;
 
+  needle_len = needle - lookfor;
+
+#ifdef FILTER_VEC
+  /* Narrow the search to positions matching the needle's first and
+     last bytes, a vector at a time.  Two-Way takes over if too many
+     candidates fail verification.  */
+  if (needle_len >= 2 && needle_len <= FILTER_MAX_NEEDLE)
+    {
+      const unsigned char *start = (const unsigned char *) searchee + 1;
+      const unsigned char *found;
+      const unsigned char *resume;
+
+      haystack_len = needle_len - 1;
+      found = filter_search (start, &haystack_len, 1,
+			     (const unsigned char *) lookfor, needle_len,
+			     (const unsigned char *) lookfor,
+			     (const unsigned char *) needle - 1, &resume);
+      if (found || !resume)
+	return (char *) found;
+      haystack = (const char *) resume;
+      haystack_len -= resume - start;
+      /* AVAILABLE assumes no more than NEEDLE_LEN bytes are known.  */
+      if (haystack_len > needle_len)
+        haystack_len = needle_len;
+      goto two_way;
+    }
+#endif
+
   /* Reduce the size of haystack using strchr, since it has a smaller
      linear coefficient than the Two-Way algorithm.  */
-  needle_len = needle - lookfor;
   haystack = strchr (searchee + 1, *lookfor);
   if (!haystack || needle_len == 1)
     return (char *) haystack;
   haystack_len = (haystack > searchee + needle_len ? 1
 		  : needle_len + searchee - haystack);
 
+#ifdef FILTER_VEC
+ two_way:
+#endif
   /* Perform the search.  */
   if (needle_len < LONG_NEEDLE_THRESHOLD)
     return two_way_short_needle ((const unsigned char *) haystack,
@@ -32,8 +32,10 @@ DESCRIPTION
 	copying takes place between objects that overlap, the behavior
 	is undefined.
 
-	(NOT Cygwin:) The current implementation of <<strxfrm>> simply copies
-	the input and does not support any language-specific transformations.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<strxfrm>> copies
+	the input.  In other locales it stores a sort key made of the
+	weights <<strcoll>> compares, which is several times as long
+	as the input.
 
 RETURNS
 	The <<strxfrm>> function returns the length of the transformed string
@@ -51,6 +53,7 @@ QUICKREF
 */
 
 #include <string.h>
+#include "local.h"
 
 size_t
 _DEFUN (strxfrm, (s1, s2, n),
@@ -59,6 +62,12 @@ _DEFUN (strxfrm, (s1, s2, n),
 	size_t n)
 {
   size_t res;
+#ifdef _MB_CAPABLE
+  struct __locale_t *locale = __get_current_locale ();
+
+  if (__ucoll_enabled (locale))
+    return __ucoll_strxfrm (s1, s2, n, locale);
+#endif
   res = 0;
   while (n-- > 0)
     {
@@ -25,8 +25,10 @@ DESCRIPTION
 	copying takes place between objects that overlap, the behavior
 	is undefined.
 
-	(NOT Cygwin:) The current implementation of <<strxfrm_l>> simply copies
-	the input and does not support any language-specific transformations.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<strxfrm_l>> copies
+	the input.  In other locales it stores a sort key made of the
+	weights <<strcoll_l>> compares, which is several times as long
+	as the input.
 
 	If <[locale]> is LC_GLOBAL_LOCALE or not a valid locale object, the
 	behaviour is undefined.
@@ -47,12 +49,17 @@ QUICKREF
 */
 
 #include <string.h>
+#include "local.h"
 
 size_t
 strxfrm_l (char *__restrict s1, const char *__restrict s2, size_t n,
 	   struct __locale_t *locale)
 {
   size_t res;
+#ifdef _MB_CAPABLE
+  if (__ucoll_enabled (locale))
+    return __ucoll_strxfrm (s1, s2, n, locale);
+#endif
   res = 0;
   while (n-- > 0)
     {
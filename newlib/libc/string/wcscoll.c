@@ -21,8 +21,12 @@ DESCRIPTION
 	using an interpretation appropriate to the current <<LC_COLLATE>>
 	state.
 
-	(NOT Cygwin:) The current implementation of <<wcscoll>> simply
-	uses <<wcscmp>> and does not support any language-specific sorting.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<wcscoll>> is the same
+	as <<wcscmp>>.  In other locales it compares base letters first,
+	then accents, then case, in the default order of the Unicode
+	Collation Algorithm for Latin, Greek and Cyrillic letters, digits
+	and common punctuation, and orders other characters by code point.
+	Strings that are still equal are ordered by <<wcscmp>>.
 
 RETURNS
 	If the first string is greater than the second string,
@@ -37,6 +41,7 @@ PORTABILITY
 
 #include <_ansi.h>
 #include <wchar.h>
+#include "local.h"
 
 int
 _DEFUN (wcscoll, (a, b),
@@ -44,5 +49,11 @@ _DEFUN (wcscoll, (a, b),
 	_CONST wchar_t *b)
 
 {
+#ifdef _MB_CAPABLE
+  struct __locale_t *locale = __get_current_locale ();
+
+  if (__ucoll_enabled (locale))
+    return __ucoll_wcscoll (a, b, locale);
+#endif
   return wcscmp (a, b);
 }
@@ -16,8 +16,12 @@ DESCRIPTION
 	using an interpretation appropriate to the current <<LC_COLLATE>>
 	state.
 
-	(NOT Cygwin:) The current implementation of <<wcscoll_l>> simply
-	uses <<wcscmp>> and does not support any language-specific sorting.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<wcscoll_l>> is the same
+	as <<wcscmp>>.  In other locales it compares base letters first,
+	then accents, then case, in the default order of the Unicode
+	Collation Algorithm for Latin, Greek and Cyrillic letters, digits
+	and common punctuation, and orders other characters by code point.
+	Strings that are still equal are ordered by <<wcscmp>>.
 
 	If <[locale]> is LC_GLOBAL_LOCALE or not a valid locale object, the
 	behaviour is undefined.
@@ -35,9 +39,14 @@ PORTABILITY
 
 #include <_ansi.h>
 #include <wchar.h>
+#include "local.h"
 
 int
 wcscoll_l (const wchar_t *a, const wchar_t *b, struct __locale_t *locale)
 {
+#ifdef _MB_CAPABLE
+  if (__ucoll_enabled (locale))
+    return __ucoll_wcscoll (a, b, locale);
+#endif
   return wcscmp (a, b);
 }
@@ -27,8 +27,10 @@ DESCRIPTION
 
 	If <[n]> is 0, <[stra]> may be a NULL pointer.
 
-	(NOT Cygwin:) The current implementation of <<wcsxfrm>> simply uses
-	<<wcslcpy>> and does not support any language-specific transformations.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<wcsxfrm>> copies
+	the input.  In other locales it stores a sort key made of the
+	weights <<wcscoll>> compares, which is several times as long
+	as the input.
 
 RETURNS
 	<<wcsxfrm>> returns the length of the transformed wide character
@@ -41,6 +43,7 @@ PORTABILITY
 
 #include <_ansi.h>
 #include <wchar.h>
+#include "local.h"
 
 size_t
 _DEFUN (wcsxfrm, (a, b, n),
@@ -49,5 +52,11 @@ _DEFUN (wcsxfrm, (a, b, n),
 	size_t n)
 
 {
+#ifdef _MB_CAPABLE
+  struct __locale_t *locale = __get_current_locale ();
+
+  if (__ucoll_enabled (locale))
+    return __ucoll_wcsxfrm (a, b, n, locale);
+#endif
   return wcslcpy (a, b, n);
 }
@@ -24,8 +24,10 @@ DESCRIPTION
 	If <[locale]> is LC_GLOBAL_LOCALE or not a valid locale object, the
 	behaviour is undefined.
 
-	(NOT Cygwin:) The current implementation of <<wcsxfrm_l>> simply uses
-	<<wcslcpy>> and does not support any language-specific transformations.
+	(NOT Cygwin:) In the "C" and "POSIX" locales <<wcsxfrm_l>> copies
+	the input.  In other locales it stores a sort key made of the
+	weights <<wcscoll_l>> compares, which is several times as long
+	as the input.
 
 RETURNS
 	<<wcsxfrm_l>> returns the length of the transformed wide character
@@ -38,10 +40,15 @@ PORTABILITY
 
 #include <_ansi.h>
 #include <wchar.h>
+#include "local.h"
 
 size_t
 wcsxfrm_l (wchar_t *__restrict a, const wchar_t *__restrict b, size_t n,
 	   struct __locale_t *locale)
 {
+#ifdef _MB_CAPABLE
+  if (__ucoll_enabled (locale))
+    return __ucoll_wcsxfrm (a, b, n, locale);
+#endif
   return wcslcpy (a, b, n);
 }
@@ -180,6 +180,9 @@ _dl_close (void *_map)
       assert (imap->l_type == lt_loaded || imap->l_opencount > 0);
     }
 
+  /* Cached lookups may name objects or scopes about to go away.  */
+  _dl_lookup_cache_flush ();
+
   /* Notify the debugger we are about to remove some loaded objects.  */
   _r_debug.r_state = RT_DELETE;
   _dl_debug_state ();
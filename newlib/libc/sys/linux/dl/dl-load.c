@@ -1149,7 +1149,7 @@ _dl_map_object_from_fd (const char *name, int fd, struct filebuf *fbp,
       goto call_lose;
     }
 
-  if (l->l_info[DT_HASH])
+  if (l->l_info[DT_HASH] || l->l_info[ADDRIDX (DT_GNU_HASH)])
     _dl_setup_hash (l);
 
   /* If this object has DT_SYMBOLIC set modify now its scope.  We don't
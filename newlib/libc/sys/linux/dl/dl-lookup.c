@@ -76,6 +76,152 @@ unsigned long int _dl_num_relocations;
 #include "do-lookup.h"
 
 
+/* Cache of successful lookups, shared by relocation processing, lazy
+   PLT fixups and dlsym.  An entry is keyed by the name's hash, the
+   version asked for, the type class and the scope list searched.  A
+   definition found in a scope stays the first one there while objects
+   are only added, so entries need to be dropped only when objects are
+   unloaded; see _dl_lookup_cache_flush.  Each entry records the cache
+   generation it was filled in, and a flush starts a new generation, so
+   a search that overlapped a flush cannot store a stale result.  */
+#define LOOKUP_CACHE_SIZE	512	/* Must be a power of two.  */
+#define LOOKUP_CACHE_SCOPES	4	/* Longest scope list cached.  */
+
+struct lookup_cache_entry
+  {
+    unsigned long int hash;
+    int type_class;
+    struct r_scope_elem *scope[LOOKUP_CACHE_SCOPES];
+    /* Version asked for; VNAME is NULL for unversioned lookups.  */
+    const char *vname;
+    const char *vfilename;
+    ElfW(Word) vhash;
+    int vhidden;
+    /* The definition found, or NULL for an unused entry.  */
+    const ElfW(Sym) *sym;
+    struct link_map *map;
+    unsigned int gen;
+  };
+
+static struct lookup_cache_entry lookup_cache[LOOKUP_CACHE_SIZE];
+static unsigned int lookup_cache_gen;
+__libc_lock_define_initialized (static, lookup_cache_lock)
+
+static inline struct lookup_cache_entry *
+lookup_cache_slot (unsigned long int hash,
+		   const struct r_found_version *version)
+{
+  if (version != NULL)
+    hash ^= version->hash;
+  return &lookup_cache[hash & (LOOKUP_CACHE_SIZE - 1)];
+}
+
+static inline int
+lookup_cache_streq (const char *s1, const char *s2)
+{
+  return s1 == s2 || (s1 != NULL && s2 != NULL && strcmp (s1, s2) == 0);
+}
+
+/* If the definition of UNDEF_NAME for this lookup is cached, store it
+   in *RESULT and return nonzero.  Otherwise store the current cache
+   generation in *GEN, for lookup_cache_put.  */
+static int
+lookup_cache_get (const char *undef_name, unsigned long int hash,
+		  const struct r_found_version *version, int type_class,
+		  struct r_scope_elem *symbol_scope[], struct sym_val *result,
+		  unsigned int *gen)
+{
+  struct lookup_cache_entry *e = lookup_cache_slot (hash, version);
+  int found = 0;
+  size_t i;
+
+  __libc_lock_lock (lookup_cache_lock);
+  *gen = lookup_cache_gen;
+  if (e->sym == NULL || e->gen != lookup_cache_gen || e->hash != hash
+      || e->type_class != type_class)
+    goto out;
+  for (i = 0; i < LOOKUP_CACHE_SCOPES; ++i)
+    {
+      if (e->scope[i] != symbol_scope[i])
+	goto out;
+      if (symbol_scope[i] == NULL)
+	break;
+    }
+  if (version == NULL
+      ? e->vname != NULL
+      : (e->vname == NULL || e->vhash != version->hash
+	 || e->vhidden != version->hidden
+	 || strcmp (e->vname, version->name) != 0
+	 || ! lookup_cache_streq (e->vfilename, version->filename)))
+    goto out;
+  if (strcmp ((const char *) D_PTR (e->map, l_info[DT_STRTAB])
+	      + e->sym->st_name, undef_name) != 0)
+    goto out;
+  result->s = e->sym;
+  result->m = e->map;
+  found = 1;
+out:
+  __libc_lock_unlock (lookup_cache_lock);
+  return found;
+}
+
+/* Remember RESULT, found by a search that began in generation GEN.  */
+static void
+lookup_cache_put (unsigned long int hash,
+		  const struct r_found_version *version, int type_class,
+		  struct r_scope_elem *symbol_scope[],
+		  const struct sym_val *result, unsigned int gen)
+{
+  struct lookup_cache_entry *e;
+  size_t i;
+
+  /* A weak definition may yet be overridden by an object added to the
+     scope later.  */
+  if (_dl_dynamic_weak && ELFW(ST_BIND) (result->s->st_info) == STB_WEAK)
+    return;
+  for (i = 0; symbol_scope[i] != NULL; ++i)
+    if (i == LOOKUP_CACHE_SCOPES - 1)
+      return;
+
+  e = lookup_cache_slot (hash, version);
+  __libc_lock_lock (lookup_cache_lock);
+  /* Objects may have been unloaded since the search started.  */
+  if (gen != lookup_cache_gen)
+    goto out;
+  e->gen = gen;
+  e->hash = hash;
+  e->type_class = type_class;
+  memcpy (e->scope, symbol_scope, (i + 1) * sizeof (e->scope[0]));
+  if (version != NULL)
+    {
+      e->vname = version->name;
+      e->vfilename = version->filename;
+      e->vhash = version->hash;
+      e->vhidden = version->hidden;
+    }
+  else
+    e->vname = NULL;
+  e->sym = result->s;
+  e->map = result->m;
+out:
+  __libc_lock_unlock (lookup_cache_lock);
+}
+
+/* Forget all cached lookups.  Must be called before objects are
+   unloaded.  */
+void
+internal_function
+_dl_lookup_cache_flush (void)
+{
+  __libc_lock_lock (lookup_cache_lock);
+  /* Entries of older generations are ignored; clear them only when
+     the counter comes round again.  */
+  if (++lookup_cache_gen == 0)
+    memset (lookup_cache, '\0', sizeof lookup_cache);
+  __libc_lock_unlock (lookup_cache_lock);
+}
+
+
 /* Add extra dependency on MAP to UNDEF_MAP.  */
 static int
 internal_function
@@ -191,14 +337,16 @@ add_dependency (struct link_map *undef_map, struct link_map *map)
 
 static int
 internal_function
-_dl_do_lookup (const char *undef_name, unsigned long int hash,
-	       const ElfW(Sym) *ref, struct sym_val *result,
+_dl_do_lookup (const char *undef_name, unsigned long int new_hash,
+	       unsigned long int *old_hash, const ElfW(Sym) *ref,
+	       struct sym_val *result,
 	       struct r_scope_elem *scope, size_t i,
 	       struct link_map *skip, int type_class);
 static int
 internal_function
-_dl_do_lookup_versioned (const char *undef_name, unsigned long int hash,
-			 const ElfW(Sym) *ref, struct sym_val *result,
+_dl_do_lookup_versioned (const char *undef_name, unsigned long int new_hash,
+			 unsigned long int *old_hash, const ElfW(Sym) *ref,
+			 struct sym_val *result,
 			 struct r_scope_elem *scope, size_t i,
 			 const struct r_found_version *const version,
 			 struct link_map *skip, int type_class);
@@ -213,35 +361,46 @@ _dl_lookup_symbol (const char *undef_name, struct link_map *undef_map,
 		   const ElfW(Sym) **ref, struct r_scope_elem *symbol_scope[],
 		   int type_class, int explicit)
 {
-  unsigned long int hash = _dl_elf_hash (undef_name);
+  const unsigned long int new_hash = _dl_new_hash (undef_name);
+  unsigned long int old_hash = 0xffffffff;
   struct sym_val current_value = { NULL, NULL };
   struct r_scope_elem **scope;
+  unsigned int gen;
   int protected;
 
   ++_dl_num_relocations;
 
-  /* Search the relevant loaded objects for a definition.  */
-  for (scope = symbol_scope; *scope; ++scope)
-    if (do_lookup (undef_name, hash, *ref, &current_value, *scope, 0, NULL,
-		   type_class))
-      {
-	/* We have to check whether this would bind UNDEF_MAP to an object
-	   in the global scope which was dynamically loaded.  In this case
-	   we have to prevent the latter from being unloaded unless the
-	   UNDEF_MAP object is also unloaded.  */
-	if (__builtin_expect (current_value.m->l_type == lt_loaded, 0)
-	    /* Don't do this for explicit lookups as opposed to implicit
-	       runtime lookups.  */
-	    && ! explicit
-	    /* Add UNDEF_MAP to the dependencies.  */
-	    && add_dependency (undef_map, current_value.m) < 0)
-	  /* Something went wrong.  Perhaps the object we tried to reference
-	     was just removed.  Try finding another definition.  */
-	  return _dl_lookup_symbol (undef_name, undef_map, ref, symbol_scope,
-				    type_class, 0);
+  /* Search the relevant loaded objects for a definition, unless an
+     earlier lookup already did.  */
+  if (! lookup_cache_get (undef_name, new_hash, NULL, type_class,
+			  symbol_scope, &current_value, &gen))
+    for (scope = symbol_scope; *scope; ++scope)
+      if (do_lookup (undef_name, new_hash, &old_hash, *ref, &current_value,
+		     *scope, 0, NULL, type_class))
+	{
+	  lookup_cache_put (new_hash, NULL, type_class, symbol_scope,
+			    &current_value, gen);
+	  break;
+	}
 
-	break;
-      }
+  /* We have to check whether this would bind UNDEF_MAP to an object
+     in the global scope which was dynamically loaded.  In this case
+     we have to prevent the latter from being unloaded unless the
+     UNDEF_MAP object is also unloaded.  */
+  if (current_value.s != NULL
+      && __builtin_expect (current_value.m->l_type == lt_loaded, 0)
+      /* Don't do this for explicit lookups as opposed to implicit
+	 runtime lookups.  */
+      && ! explicit
+      /* Add UNDEF_MAP to the dependencies.  */
+      && add_dependency (undef_map, current_value.m) < 0)
+    {
+      /* Something went wrong.  Perhaps the object we tried to reference
+	 was just removed.  Try finding another definition.  */
+      _dl_lookup_cache_flush ();
+      return _dl_lookup_symbol (undef_name, undef_map, ref, symbol_scope,
+				type_class, 0);
+    }
 
   if (__builtin_expect (current_value.s == NULL, 0))
     {
@@ -285,8 +444,9 @@ _dl_lookup_symbol (const char *undef_name, struct link_map *undef_map,
       struct sym_val protected_value = { NULL, NULL };
 
       for (scope = symbol_scope; *scope; ++scope)
-	if (_dl_do_lookup (undef_name, hash, *ref, &protected_value, *scope,
-			   0, NULL, ELF_RTYPE_CLASS_PLT))
+	if (_dl_do_lookup (undef_name, new_hash, &old_hash, *ref,
+			   &protected_value, *scope, 0, NULL,
+			   ELF_RTYPE_CLASS_PLT))
 	  break;
 
       if (protected_value.s == NULL || protected_value.m == undef_map)
@@ -313,7 +473,8 @@ _dl_lookup_symbol_skip (const char *undef_name,
 			struct link_map *skip_map)
 {
   const char *reference_name = undef_map ? undef_map->l_name : NULL;
-  const unsigned long int hash = _dl_elf_hash (undef_name);
+  const unsigned long int new_hash = _dl_new_hash (undef_name);
+  unsigned long int old_hash = 0xffffffff;
   struct sym_val current_value = { NULL, NULL };
   struct r_scope_elem **scope;
   size_t i;
@@ -326,11 +487,11 @@ _dl_lookup_symbol_skip (const char *undef_name,
   for (i = 0; (*scope)->r_list[i] != skip_map; ++i)
     assert (i < (*scope)->r_nlist);
 
-  if (! _dl_do_lookup (undef_name, hash, *ref, &current_value, *scope, i,
-		       skip_map, 0))
+  if (! _dl_do_lookup (undef_name, new_hash, &old_hash, *ref, &current_value,
+		       *scope, i, skip_map, 0))
     while (*++scope)
-      if (_dl_do_lookup (undef_name, hash, *ref, &current_value, *scope, 0,
-			 skip_map, 0))
+      if (_dl_do_lookup (undef_name, new_hash, &old_hash, *ref, &current_value,
+			 *scope, 0, skip_map, 0))
 	break;
 
   if (__builtin_expect (current_value.s == NULL, 0))
@@ -361,11 +522,13 @@ _dl_lookup_symbol_skip (const char *undef_name,
       struct sym_val protected_value = { NULL, NULL };
 
       if (i >= (*scope)->r_nlist
-	  || !_dl_do_lookup (undef_name, hash, *ref, &protected_value, *scope,
-			     i, skip_map, ELF_RTYPE_CLASS_PLT))
+	  || !_dl_do_lookup (undef_name, new_hash, &old_hash, *ref,
+			     &protected_value, *scope, i, skip_map,
+			     ELF_RTYPE_CLASS_PLT))
 	while (*++scope)
-	  if (_dl_do_lookup (undef_name, hash, *ref, &protected_value, *scope,
-			     0, skip_map, ELF_RTYPE_CLASS_PLT))
+	  if (_dl_do_lookup (undef_name, new_hash, &old_hash, *ref,
+			     &protected_value, *scope, 0, skip_map,
+			     ELF_RTYPE_CLASS_PLT))
 	    break;
 
       if (protected_value.s == NULL || protected_value.m == undef_map)
@@ -392,60 +555,72 @@ _dl_lookup_versioned_symbol (const char *undef_name,
 			     const struct r_found_version *version,
 			     int type_class, int explicit)
 {
-  unsigned long int hash = _dl_elf_hash (undef_name);
+  const unsigned long int new_hash = _dl_new_hash (undef_name);
+  unsigned long int old_hash = 0xffffffff;
   struct sym_val current_value = { NULL, NULL };
   struct r_scope_elem **scope;
+  unsigned int gen;
   int protected;
 
   ++_dl_num_relocations;
 
-  /* Search the relevant loaded objects for a definition.  */
-  for (scope = symbol_scope; *scope; ++scope)
-    {
-      int res = do_lookup_versioned (undef_name, hash, *ref, &current_value,
-				     *scope, 0, version, NULL, type_class);
-      if (res > 0)
-	{
-	  /* We have to check whether this would bind UNDEF_MAP to an object
-	     in the global scope which was dynamically loaded.  In this case
-	     we have to prevent the latter from being unloaded unless the
-	     UNDEF_MAP object is also unloaded.  */
-	  if (__builtin_expect (current_value.m->l_type == lt_loaded, 0)
-	      /* Don't do this for explicit lookups as opposed to implicit
-		 runtime lookups.  */
-	      && ! explicit
-	      /* Add UNDEF_MAP to the dependencies.  */
-	      && add_dependency (undef_map, current_value.m) < 0)
-	    /* Something went wrong.  Perhaps the object we tried to reference
-	       was just removed.  Try finding another definition.  */
-	    return _dl_lookup_versioned_symbol (undef_name, undef_map, ref,
-						symbol_scope, version,
-						type_class, 0);
-
-	  break;
-	}
-
-      if (__builtin_expect (res, 0) < 0)
-	{
-	  /* Oh, oh.  The file named in the relocation entry does not
-	     contain the needed symbol.  */
-	  const char *reference_name = undef_map ? undef_map->l_name : NULL;
+  /* Search the relevant loaded objects for a definition, unless an
+     earlier lookup already did.  */
+  if (! lookup_cache_get (undef_name, new_hash, version, type_class,
+			  symbol_scope, &current_value, &gen))
+    for (scope = symbol_scope; *scope; ++scope)
+      {
+	int res = do_lookup_versioned (undef_name, new_hash, &old_hash, *ref,
+				       &current_value, *scope, 0, version, NULL,
+				       type_class);
+	if (res > 0)
+	  {
+	    lookup_cache_put (new_hash, version, type_class, symbol_scope,
+			      &current_value, gen);
+	    break;
+	  }
+
+	if (__builtin_expect (res, 0) < 0)
+	  {
+	    /* Oh, oh.  The file named in the relocation entry does not
+	       contain the needed symbol.  */
+	    const char *reference_name = undef_map ? undef_map->l_name : NULL;
+
+	    /* XXX We cannot translate the message.  */
+	    _dl_signal_cerror (0, (reference_name && reference_name[0]
+				   ? reference_name
+				   : (_dl_argv[0] ?: "<main program>")),
+			       N_("relocation error"),
+			       make_string ("symbol ", undef_name, ", version ",
+					    version->name,
+					    " not defined in file ",
+					    version->filename,
+					    " with link time reference",
+					    res == -2
+					    ? " (no version symbols)" : ""));
+	    *ref = NULL;
+	    return 0;
+	  }
+      }
 
-	  /* XXX We cannot translate the message.  */
-	  _dl_signal_cerror (0, (reference_name && reference_name[0]
-				 ? reference_name
-				 : (_dl_argv[0] ?: "<main program>")),
-			     N_("relocation error"),
-			     make_string ("symbol ", undef_name, ", version ",
-					  version->name,
-					  " not defined in file ",
-					  version->filename,
-					  " with link time reference",
-					  res == -2
-					  ? " (no version symbols)" : ""));
-	  *ref = NULL;
-	  return 0;
-	}
+  /* We have to check whether this would bind UNDEF_MAP to an object
+     in the global scope which was dynamically loaded.  In this case
+     we have to prevent the latter from being unloaded unless the
+     UNDEF_MAP object is also unloaded.  */
+  if (current_value.s != NULL
+      && __builtin_expect (current_value.m->l_type == lt_loaded, 0)
+      /* Don't do this for explicit lookups as opposed to implicit
+	 runtime lookups.  */
+      && ! explicit
+      /* Add UNDEF_MAP to the dependencies.  */
+      && add_dependency (undef_map, current_value.m) < 0)
+    {
+      /* Something went wrong.  Perhaps the object we tried to reference
+	 was just removed.  Try finding another definition.  */
+      _dl_lookup_cache_flush ();
+      return _dl_lookup_versioned_symbol (undef_name, undef_map, ref,
+					  symbol_scope, version, type_class,
+					  0);
     }
 
   if (__builtin_expect (current_value.s == NULL, 0))
@@ -494,9 +669,9 @@ _dl_lookup_versioned_symbol (const char *undef_name,
       struct sym_val protected_value = { NULL, NULL };
 
       for (scope = symbol_scope; *scope; ++scope)
-	if (_dl_do_lookup_versioned (undef_name, hash, *ref, &protected_value,
-				     *scope, 0, version, NULL,
-				     ELF_RTYPE_CLASS_PLT))
+	if (_dl_do_lookup_versioned (undef_name, new_hash, &old_hash, *ref,
+				     &protected_value, *scope, 0, version,
+				     NULL, ELF_RTYPE_CLASS_PLT))
 	  break;
 
       if (protected_value.s == NULL || protected_value.m == undef_map)
@@ -522,7 +697,8 @@ _dl_lookup_versioned_symbol_skip (const char *undef_name,
 				  struct link_map *skip_map)
 {
   const char *reference_name = undef_map ? undef_map->l_name : NULL;
-  const unsigned long int hash = _dl_elf_hash (undef_name);
+  const unsigned long int new_hash = _dl_new_hash (undef_name);
+  unsigned long int old_hash = 0xffffffff;
   struct sym_val current_value = { NULL, NULL };
   struct r_scope_elem **scope;
   size_t i;
@@ -535,11 +711,13 @@ _dl_lookup_versioned_symbol_skip (const char *undef_name,
   for (i = 0; (*scope)->r_list[i] != skip_map; ++i)
     assert (i < (*scope)->r_nlist);
 
-  if (! _dl_do_lookup_versioned (undef_name, hash, *ref, &current_value,
-				 *scope, i, version, skip_map, 0))
+  if (! _dl_do_lookup_versioned (undef_name, new_hash, &old_hash, *ref,
+				 &current_value, *scope, i, version, skip_map,
+				 0))
     while (*++scope)
-      if (_dl_do_lookup_versioned (undef_name, hash, *ref, &current_value,
-				   *scope, 0, version, skip_map, 0))
+      if (_dl_do_lookup_versioned (undef_name, new_hash, &old_hash, *ref,
+				   &current_value, *scope, 0, version,
+				   skip_map, 0))
 	break;
 
   if (__builtin_expect (current_value.s == NULL, 0))
@@ -588,11 +766,11 @@ _dl_lookup_versioned_symbol_skip (const char *undef_name,
       struct sym_val protected_value = { NULL, NULL };
 
       if (i >= (*scope)->r_nlist
-	  || !_dl_do_lookup_versioned (undef_name, hash, *ref,
+	  || !_dl_do_lookup_versioned (undef_name, new_hash, &old_hash, *ref,
 				       &protected_value, *scope, i, version,
 				       skip_map, ELF_RTYPE_CLASS_PLT))
 	while (*++scope)
-	  if (_dl_do_lookup_versioned (undef_name, hash, *ref,
+	  if (_dl_do_lookup_versioned (undef_name, new_hash, &old_hash, *ref,
 				       &protected_value, *scope, 0, version,
 				       skip_map, ELF_RTYPE_CLASS_PLT))
 	    break;
@@ -617,6 +795,32 @@ _dl_setup_hash (struct link_map *map)
   Elf_Symndx *hash;
   Elf_Symndx nchain;
 
+  if (map->l_info[ADDRIDX (DT_GNU_HASH)] != NULL)
+    {
+      Elf32_Word *hash32 = (void *)
+	(map->l_addr + map->l_info[ADDRIDX (DT_GNU_HASH)]->d_un.d_ptr);
+      Elf32_Word symbias;
+      Elf32_Word bitmask_nwords;
+
+      /* The header is nbuckets, symbias, bitmask_nwords and shift,
+	 followed by the Bloom filter words, the buckets and the hash
+	 values of symbols symbias onwards.  */
+      map->l_nbuckets = *hash32++;
+      symbias = *hash32++;
+      bitmask_nwords = *hash32++;
+      /* bitmask_nwords is a power of two.  */
+      map->l_gnu_bitmask_idxbits = bitmask_nwords - 1;
+      map->l_gnu_shift = *hash32++;
+
+      map->l_gnu_bitmask = (ElfW(Addr) *) hash32;
+      hash32 += __ELF_NATIVE_CLASS / 32 * bitmask_nwords;
+
+      map->l_gnu_buckets = hash32;
+      hash32 += map->l_nbuckets;
+      map->l_gnu_chain_zero = hash32 - symbias;
+      return;
+    }
+
   if (!map->l_info[DT_HASH])
     return;
   hash = (void *)(map->l_addr + map->l_info[DT_HASH]->d_un.d_ptr);
@@ -632,23 +836,25 @@ _dl_setup_hash (struct link_map *map)
    case, not everywhere.  */
 static int
 internal_function
-_dl_do_lookup (const char *undef_name, unsigned long int hash,
-	       const ElfW(Sym) *ref, struct sym_val *result,
+_dl_do_lookup (const char *undef_name, unsigned long int new_hash,
+	       unsigned long int *old_hash, const ElfW(Sym) *ref,
+	       struct sym_val *result,
 	       struct r_scope_elem *scope, size_t i,
 	       struct link_map *skip, int type_class)
 {
-  return do_lookup (undef_name, hash, ref, result, scope, i, skip,
-		    type_class);
+  return do_lookup (undef_name, new_hash, old_hash, ref, result, scope, i,
+		    skip, type_class);
 }
 
 static int
 internal_function
-_dl_do_lookup_versioned (const char *undef_name, unsigned long int hash,
-			 const ElfW(Sym) *ref, struct sym_val *result,
+_dl_do_lookup_versioned (const char *undef_name, unsigned long int new_hash,
+			 unsigned long int *old_hash, const ElfW(Sym) *ref,
+			 struct sym_val *result,
 			 struct r_scope_elem *scope, size_t i,
 			 const struct r_found_version *const version,
 			 struct link_map *skip, int type_class)
 {
-  return do_lookup_versioned (undef_name, hash, ref, result, scope, i,
-			      version, skip, type_class);
+  return do_lookup_versioned (undef_name, new_hash, old_hash, ref, result,
+			      scope, i, version, skip, type_class);
 }
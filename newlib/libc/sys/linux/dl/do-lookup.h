@@ -20,16 +20,100 @@
 #if VERSIONED
 # define FCT do_lookup_versioned
 # define ARG const struct r_found_version *const version,
+# define CHECK check_match_versioned
+# define CHECK_ARG const struct r_found_version *const version
+# define CHECK_PASS version
 #else
 # define FCT do_lookup
 # define ARG
+# define CHECK check_match
+# define CHECK_ARG int *num_versions, const ElfW(Sym) **versioned_sym
+# define CHECK_PASS &num_versions, &versioned_sym
 #endif
 
+/* Return SYM, entry SYMIDX of MAP's symbol table, if it is a definition
+   of UNDEF_NAME we can use, or NULL.  */
+static inline const ElfW(Sym) *
+CHECK (const char *undef_name, const ElfW(Sym) *ref, const ElfW(Sym) *sym,
+       Elf_Symndx symidx, const char *strtab, const ElfW(Half) *verstab,
+       struct link_map *map, int type_class, CHECK_ARG)
+{
+  assert (ELF_RTYPE_CLASS_PLT == 1);
+  if (sym->st_value == 0 || /* No value.  */
+      /* ((type_class & ELF_RTYPE_CLASS_PLT)
+	  && (sym->st_shndx == SHN_UNDEF)) */
+      (type_class & (sym->st_shndx == SHN_UNDEF)))
+    return NULL;
+
+  if (ELFW(ST_TYPE) (sym->st_info) > STT_FUNC
+      && ELFW(ST_TYPE) (sym->st_info) != STT_COMMON)
+    /* Ignore all but STT_NOTYPE, STT_OBJECT, STT_COMMON and
+       STT_FUNC entries since these are no code/data definitions.  */
+    return NULL;
+
+  if (sym != ref && strcmp (strtab + sym->st_name, undef_name))
+    /* Not the symbol we are looking for.  */
+    return NULL;
+
+#if VERSIONED
+  if (__builtin_expect (verstab == NULL, 0))
+    {
+      /* We need a versioned symbol but haven't found any.  If
+	 this is the object which is referenced in the verneed
+	 entry it is a bug in the library since a symbol must
+	 not simply disappear.
+
+	 It would also be a bug in the object since it means that
+	 the list of required versions is incomplete and so the
+	 tests in dl-version.c haven't found a problem.*/
+      assert (version->filename == NULL
+	      || ! _dl_name_match_p (version->filename, map));
+
+      /* Otherwise we accept the symbol.  */
+    }
+  else
+    {
+      /* We can match the version information or use the
+	 default one if it is not hidden.  */
+      ElfW(Half) ndx = verstab[symidx] & 0x7fff;
+      if ((map->l_versions[ndx].hash != version->hash
+	   || strcmp (map->l_versions[ndx].name, version->name))
+	  && (version->hidden || map->l_versions[ndx].hash
+	      || (verstab[symidx] & 0x8000)))
+	/* It's not the version we want.  */
+	return NULL;
+    }
+#else
+  /* No specific version is selected.  When the object file
+     also does not define a version we have a match.
+     Otherwise we accept the default version, or in case there
+     is only one version defined, this one version.  */
+  if (verstab != NULL)
+    {
+      ElfW(Half) ndx = verstab[symidx] & 0x7fff;
+      if (ndx > 2) /* map->l_versions[ndx].hash != 0) */
+	{
+	  /* Don't accept hidden symbols.  */
+	  if ((verstab[symidx] & 0x8000) == 0 && (*num_versions)++ == 0)
+	    /* No version so far.  */
+	    *versioned_sym = sym;
+	  return NULL;
+	}
+    }
+#endif
+
+  /* There cannot be another entry for this symbol.  */
+  return sym;
+}
+
 /* Inner part of the lookup functions.  We return a value > 0 if we
    found the symbol, the value 0 if nothing is found and < 0 if
-   something bad happened.  */
+   something bad happened.  NEW_HASH is the DT_GNU_HASH hash of
+   UNDEF_NAME; *OLD_HASH is its DT_HASH hash, or 0xffffffff if that
+   has not been needed yet.  */
 static inline int
-FCT (const char *undef_name, unsigned long int hash, const ElfW(Sym) *ref,
+FCT (const char *undef_name, unsigned long int new_hash,
+     unsigned long int *old_hash, const ElfW(Sym) *ref,
      struct sym_val *result, struct r_scope_elem *scope, size_t i, ARG
      struct link_map *skip, int type_class)
 {
@@ -68,80 +152,61 @@ FCT (const char *undef_name, unsigned long int hash, const ElfW(Sym) *ref,
       strtab = (const void *) D_PTR (map, l_info[DT_STRTAB]);
       verstab = map->l_versyms;
 
-      /* Search the appropriate hash bucket in this object's symbol table
-	 for a definition for the same symbol name.  */
-      for (symidx = map->l_buckets[hash % map->l_nbuckets];
-	   symidx != STN_UNDEF;
-	   symidx = map->l_chain[symidx])
+      if (map->l_gnu_bitmask != NULL)
 	{
-	  sym = &symtab[symidx];
-
-	  assert (ELF_RTYPE_CLASS_PLT == 1);
-	  if (sym->st_value == 0 || /* No value.  */
-	      /* ((type_class & ELF_RTYPE_CLASS_PLT)
-		  && (sym->st_shndx == SHN_UNDEF)) */
-	      (type_class & (sym->st_shndx == SHN_UNDEF)))
-	    continue;
-
-	  if (ELFW(ST_TYPE) (sym->st_info) > STT_FUNC
-	      && ELFW(ST_TYPE) (sym->st_info) != STT_COMMON)
-	    /* Ignore all but STT_NOTYPE, STT_OBJECT, STT_COMMON and
-	       STT_FUNC entries since these are no code/data definitions.  */
-	    continue;
-
-	  if (sym != ref && strcmp (strtab + sym->st_name, undef_name))
-	    /* Not the symbol we are looking for.  */
-	    continue;
+	  /* Objects which don't define the symbol are usually rejected
+	     by the Bloom filter, which needs two bits derived from the
+	     hash to be set, without touching their symbol table.  */
+	  ElfW(Addr) bitmask_word
+	    = map->l_gnu_bitmask[(new_hash / __ELF_NATIVE_CLASS)
+				 & map->l_gnu_bitmask_idxbits];
+	  unsigned int hashbit1 = new_hash & (__ELF_NATIVE_CLASS - 1);
+	  unsigned int hashbit2 = ((new_hash >> map->l_gnu_shift)
+				   & (__ELF_NATIVE_CLASS - 1));
 
-#if VERSIONED
-	  if (__builtin_expect (verstab == NULL, 0))
-	    {
-	      /* We need a versioned symbol but haven't found any.  If
-		 this is the object which is referenced in the verneed
-		 entry it is a bug in the library since a symbol must
-		 not simply disappear.
-
-		 It would also be a bug in the object since it means that
-		 the list of required versions is incomplete and so the
-		 tests in dl-version.c haven't found a problem.*/
-	      assert (version->filename == NULL
-		      || ! _dl_name_match_p (version->filename, map));
-
-	      /* Otherwise we accept the symbol.  */
-	    }
-	  else
-	    {
-	      /* We can match the version information or use the
-		 default one if it is not hidden.  */
-	      ElfW(Half) ndx = verstab[symidx] & 0x7fff;
-	      if ((map->l_versions[ndx].hash != version->hash
-		   || strcmp (map->l_versions[ndx].name, version->name))
-		  && (version->hidden || map->l_versions[ndx].hash
-		      || (verstab[symidx] & 0x8000)))
-		/* It's not the version we want.  */
-		continue;
-	    }
-#else
-	  /* No specific version is selected.  When the object file
-	     also does not define a version we have a match.
-	     Otherwise we accept the default version, or in case there
-	     is only one version defined, this one version.  */
-	  if (verstab != NULL)
+	  if ((bitmask_word >> hashbit1) & (bitmask_word >> hashbit2) & 1)
 	    {
-	      ElfW(Half) ndx = verstab[symidx] & 0x7fff;
-	      if (ndx > 2) /* map->l_versions[ndx].hash != 0) */
+	      Elf32_Word bucket = map->l_gnu_buckets[new_hash
+						     % map->l_nbuckets];
+
+	      if (bucket != 0)
 		{
-		  /* Don't accept hidden symbols.  */
-		  if ((verstab[symidx] & 0x8000) == 0 && num_versions++ == 0)
-		    /* No version so far.  */
-		    versioned_sym = sym;
-		  continue;
+		  const Elf32_Word *hasharr = &map->l_gnu_chain_zero[bucket];
+
+		  /* The chain holds the hashes of the bucket's symbols,
+		     with the low bit set on the last one.  */
+		  do
+		    if (((*hasharr ^ new_hash) >> 1) == 0)
+		      {
+			symidx = hasharr - map->l_gnu_chain_zero;
+			sym = CHECK (undef_name, ref, &symtab[symidx], symidx,
+				     strtab, verstab, map, type_class,
+				     CHECK_PASS);
+			if (sym != NULL)
+			  goto found_it;
+		      }
+		  while ((*hasharr++ & 1u) == 0);
 		}
 	    }
-#endif
+	  /* No symbol found.  */
+	  symidx = STN_UNDEF;
+	}
+      else
+	{
+	  if (*old_hash == 0xffffffff)
+	    *old_hash = _dl_elf_hash (undef_name);
 
-	  /* There cannot be another entry for this symbol so stop here.  */
-	  goto found_it;
+	  /* Search the appropriate hash bucket in this object's symbol
+	     table for a definition for the same symbol name.  */
+	  for (symidx = map->l_buckets[*old_hash % map->l_nbuckets];
+	       symidx != STN_UNDEF;
+	       symidx = map->l_chain[symidx])
+	    {
+	      sym = CHECK (undef_name, ref, &symtab[symidx], symidx, strtab,
+			   verstab, map, type_class, CHECK_PASS);
+	      if (sym != NULL)
+		goto found_it;
+	    }
 	}
 
       /* If we have seen exactly one versioned symbol while we are
@@ -198,4 +263,7 @@ FCT (const char *undef_name, unsigned long int hash, const ElfW(Sym) *ref,
 
 #undef FCT
 #undef ARG
+#undef CHECK
+#undef CHECK_ARG
+#undef CHECK_PASS
 #undef VERSIONED
@@ -53,6 +53,13 @@ __BEGIN_DECLS
 # define D_PTR(map,i) map->i->d_un.d_ptr
 #endif
 
+/* Indices into l_info of the DT_VALRNGLO..DT_VALRNGHI and
+   DT_ADDRRNGLO..DT_ADDRRNGHI tags.  */
+#define VALIDX(tag)	(DT_NUM + DT_THISPROCNUM + DT_VERSIONTAGNUM \
+			 + DT_EXTRANUM + DT_VALTAGIDX (tag))
+#define ADDRIDX(tag)	(DT_NUM + DT_THISPROCNUM + DT_VERSIONTAGNUM \
+			 + DT_EXTRANUM + DT_VALNUM + DT_ADDRTAGIDX (tag))
+
 /* On some platforms more information than just the address of the symbol
    is needed from the lookup functions.  In this case we return the whole
    link map.  */
@@ -351,6 +358,10 @@ extern void _dl_map_object_deps (struct link_map *map,
 /* Cache the locations of MAP's hash table.  */
 extern void _dl_setup_hash (struct link_map *map) internal_function;
 
+/* Forget all cached symbol lookups.  Must be called with _dl_load_lock
+   held before any object is unmapped.  */
+extern void _dl_lookup_cache_flush (void) internal_function;
+
 
 /* Search loaded objects' symbol tables for a definition of the symbol
    referred to by UNDEF.  *SYM is the symbol table entry containing the
@@ -0,0 +1,39 @@
+/* libc/sys/linux/getentropy.c - Fill a buffer with random bytes */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define MAX_ENTROPY	256
+
+int
+getentropy (void *buf, size_t len)
+{
+	char *p = buf;
+	ssize_t n;
+	int fd;
+
+	if (len > MAX_ENTROPY)
+	{
+		errno = EIO;
+		return -1;
+	}
+	if ((fd = open ("/dev/urandom", O_RDONLY)) < 0)
+		return -1;
+	while (len > 0)
+	{
+		n = read (fd, p, len);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+		{
+			close (fd);
+			errno = EIO;
+			return -1;
+		}
+		p += n;
+		len -= n;
+	}
+	close (fd);
+	return 0;
+}
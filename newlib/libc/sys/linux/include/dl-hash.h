@@ -71,4 +71,16 @@ _dl_elf_hash (const unsigned char *name)
   return hash;
 }
 
+/* The hash function used by DT_GNU_HASH tables.  */
+static inline Elf32_Word
+_dl_new_hash (const unsigned char *name)
+{
+  Elf32_Word hash = 5381;
+  unsigned char c;
+
+  while ((c = *name++) != '\0')
+    hash = hash * 33 + c;
+  return hash;
+}
+
 #endif /* dl-hash.h */
@@ -27,6 +27,13 @@
 #include <sys/types.h>
 
 #define DT_THISPROCNUM 0
+
+/* Older <elf.h>s predate the GNU hash table.  */
+#ifndef DT_GNU_HASH
+# define DT_GNU_HASH	0x6ffffef5
+# undef DT_ADDRNUM
+# define DT_ADDRNUM	11
+#endif
 /* We use this macro to refer to ELF types independent of the native wordsize.
    `ElfW(TYPE)' is used in place of `Elf32_TYPE' or `Elf64_TYPE'.  */
 #define ElfW(type)	_ElfW (Elf, __ELF_NATIVE_CLASS, type)
@@ -137,10 +144,12 @@ struct link_map
        by DT_EXTRATAGIDX(tagvalue) and
        [DT_NUM+DT_THISPROCNUM+DT_VERSIONTAGNUM,
         DT_NUM+DT_THISPROCNUM+DT_VERSIONTAGNUM+DT_EXTRANUM)
-       are indexed by DT_EXTRATAGIDX(tagvalue) (see <elf.h>).  */
+       are indexed by DT_EXTRATAGIDX(tagvalue).  The next DT_VALNUM
+       entries are indexed by DT_VALTAGIDX(tagvalue) and the last
+       DT_ADDRNUM by DT_ADDRTAGIDX(tagvalue) (see <elf.h>).  */
 
     ElfW(Dyn) *l_info[DT_NUM + DT_THISPROCNUM + DT_VERSIONTAGNUM
-		     + DT_EXTRANUM];
+		     + DT_EXTRANUM + DT_VALNUM + DT_ADDRNUM];
     const ElfW(Phdr) *l_phdr;	/* Pointer to program header table in core.  */
     ElfW(Addr) l_entry;		/* Entry point location.  */
     ElfW(Half) l_phnum;		/* Number of program header entries.  */
@@ -163,6 +172,16 @@ struct link_map
     Elf_Symndx l_nbuckets;
     const Elf_Symndx *l_buckets, *l_chain;
 
+    /* DT_GNU_HASH table, used instead of the one above if present.
+       l_gnu_bitmask is the Bloom filter, with l_gnu_bitmask_idxbits + 1
+       words.  l_gnu_chain_zero is biased so that it can be indexed by
+       symbol number.  */
+    const ElfW(Addr) *l_gnu_bitmask;
+    Elf32_Word l_gnu_bitmask_idxbits;
+    Elf32_Word l_gnu_shift;
+    const Elf32_Word *l_gnu_buckets;
+    const Elf32_Word *l_gnu_chain_zero;
+
     unsigned int l_opencount;	/* Reference count for dlopen/dlclose.  */
     enum			/* Where this object came from.  */
       {
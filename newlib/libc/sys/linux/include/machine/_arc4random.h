@@ -0,0 +1,5 @@
+/* libc/sys/linux/include/machine/_arc4random.h - arc4random port hooks */
+
+/* One generator per thread, without a lock.  __libc_fork tells the
+   generators about new processes; see stdlib/arc4random.h.  */
+#define _ARC4RANDOM_THREAD_LOCAL __thread
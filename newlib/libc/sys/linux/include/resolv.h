@@ -209,6 +209,7 @@ struct __res_state_ext {
                                            strings */
 #define RES_NOIP6DOTINT 0x00080000      /* Do not use .ip6.int in IPv6
                                            reverse lookup */
+#define RES_CACHE       0x00100000      /* cache answers in-process */
 
 #define RES_DEFAULT     (RES_RECURSE|RES_DEFNAMES|RES_DNSRCH|RES_NOIP6DOTINT)
 
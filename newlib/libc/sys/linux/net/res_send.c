@@ -96,6 +96,7 @@ static const char rcsid[] = "$BINDId: res_send.c,v 8.38 2000/03/30 20:16:51 vixi
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <bits/libc-lock.h>
 #include "libc-symbols.h"
 
 #if PACKETSZ > 65536
@@ -194,6 +195,199 @@ static int		sock_eq(struct sockaddr_in6 *, struct sockaddr_in6 *);
 static void convaddr4to6(struct sockaddr_in6 *sa);
 void res_pquery(const res_state, const u_char *, int, FILE *);
 
+/* Answer cache, enabled with RES_CACHE ("options cache" in resolv.conf).
+ * Answers are keyed by the query's flags and question, and are shared
+ * by all threads and resolver states.  A positive answer is kept for
+ * the smallest TTL in its answer section.  A name error or an empty
+ * answer is kept for the negative TTL given by the SOA record in its
+ * authority section (RFC 2308), and not at all if there is none.
+ */
+#define RES_CACHE_SLOTS		64	/* Must be a power of two. */
+#define RES_CACHE_MAXTTL	3600
+#define RES_CACHE_KEYSZ		(2 + MAXCDNAME + QFIXEDSZ)
+
+struct res_cache_ent {
+	int	keylen;
+	u_char	key[RES_CACHE_KEYSZ];
+	time_t	stored, expires;
+	int	anslen;
+	u_char	*ans;		/* malloc'd; NULL if the slot is unused */
+};
+
+static struct res_cache_ent res_cache[RES_CACHE_SLOTS];
+__libc_lock_define_initialized (static, res_cache_lock);
+
+/*
+ * Build the cache key for query BUF in KEY: the second word of the
+ * header, then the question with its name folded to lower case.
+ * Returns the key length, or 0 if the query is not cacheable.
+ */
+static int
+res_cache_key(const u_char *buf, int buflen, u_char *key) {
+	const HEADER *hp = (const HEADER *) buf;
+	const u_char *cp = buf + HFIXEDSZ;
+	int n, i;
+
+	if (buflen < HFIXEDSZ || hp->opcode != QUERY ||
+	    ntohs(hp->qdcount) != 1 || hp->ancount != 0 ||
+	    hp->nscount != 0 || hp->arcount != 0)
+		return (0);
+	for (n = 0; ; n += cp[n] + 1) {
+		if (HFIXEDSZ + n >= buflen || (cp[n] & NS_CMPRSFLGS) != 0)
+			return (0);
+		if (cp[n] == 0)
+			break;
+	}
+	n += 1 + QFIXEDSZ;
+	if (n > MAXCDNAME + QFIXEDSZ || HFIXEDSZ + n > buflen)
+		return (0);
+	key[0] = buf[2];
+	key[1] = buf[3];
+	/* Label lengths are below 64, so folding leaves them alone. */
+	for (i = 0; i < n; i++)
+		key[2 + i] = (cp[i] >= 'A' && cp[i] <= 'Z'
+			      ? cp[i] - 'A' + 'a' : cp[i]);
+	return (2 + n);
+}
+
+static struct res_cache_ent *
+res_cache_slot(const u_char *key, int keylen) {
+	u_int32_t h = 2166136261U;
+
+	while (keylen-- > 0)
+		h = (h ^ *key++) * 16777619U;
+	return (&res_cache[h & (RES_CACHE_SLOTS - 1)]);
+}
+
+/*
+ * Take AGE seconds off the TTL of each record in answer ANS, of length
+ * ANSLEN, so that it reads as if it had just come from the server.
+ */
+static void
+res_cache_age(u_char *ans, int anslen, u_long age) {
+	ns_msg handle;
+	ns_rr rr;
+	u_long ttl;
+	int s, i;
+
+	if (age == 0 || ns_initparse(ans, anslen, &handle) < 0)
+		return;
+	for (s = ns_s_an; s < ns_s_max; s++)
+		for (i = 0; i < ns_msg_count(handle, (ns_sect) s); i++) {
+			if (ns_parserr(&handle, (ns_sect) s, i, &rr) < 0)
+				return;
+			/* OPT and TSIG use the TTL field for other things. */
+			if (ns_t_mrr_p(ns_rr_type(rr)))
+				continue;
+			ttl = ns_rr_ttl(rr);
+			/* TTL and RDLENGTH come just before the RDATA. */
+			ns_put32(ttl > age ? ttl - age : 0,
+				 ans + (ns_rr_rdata(rr) - ns_msg_base(handle))
+				 - INT16SZ - INT32SZ);
+		}
+}
+
+/*
+ * If an answer to query BUF is cached and fits in ANSSIZ bytes, copy
+ * it to ANS, with its TTLs counted down, and return its length.
+ * Otherwise return 0.
+ */
+static int
+res_cache_get(const u_char *buf, int buflen, u_char *ans, int anssiz) {
+	u_char key[RES_CACHE_KEYSZ];
+	struct res_cache_ent *ent;
+	struct timespec now;
+	u_long age = 0;
+	int keylen, n = 0;
+
+	if ((keylen = res_cache_key(buf, buflen, key)) == 0)
+		return (0);
+	ent = res_cache_slot(key, keylen);
+	evNowTime(&now);
+	__libc_lock_lock (res_cache_lock);
+	if (ent->ans != NULL && ent->keylen == keylen &&
+	    memcmp(ent->key, key, keylen) == 0 &&
+	    now.tv_sec >= ent->stored && now.tv_sec < ent->expires &&
+	    ent->anslen <= anssiz) {
+		memcpy(ans, ent->ans, ent->anslen);
+		n = ent->anslen;
+		age = now.tv_sec - ent->stored;
+	}
+	__libc_lock_unlock (res_cache_lock);
+	if (n > 0) {
+		/* Answer with this query's ID and spelling of the name. */
+		memcpy(ans, buf, 2);
+		memcpy(ans + HFIXEDSZ, buf + HFIXEDSZ, keylen - 2);
+		res_cache_age(ans, n, age);
+	}
+	return (n);
+}
+
+/*
+ * Remember ANS, of length ANSLEN, as the answer to query BUF if its
+ * records say for how long it may be kept.
+ */
+static void
+res_cache_put(const u_char *buf, int buflen, const u_char *ans, int anslen) {
+	const HEADER *anhp = (const HEADER *) ans;
+	u_char key[RES_CACHE_KEYSZ];
+	struct res_cache_ent *ent;
+	struct timespec now;
+	ns_msg handle;
+	ns_rr rr;
+	ns_sect section;
+	u_long ttl = RES_CACHE_MAXTTL, minimum;
+	int keylen, found = 0, i;
+	u_char *copy, *old;
+
+	if (anhp->tc)
+		return;
+	if (anhp->rcode == NOERROR && ntohs(anhp->ancount) > 0)
+		section = ns_s_an;
+	else if (anhp->rcode == NOERROR || anhp->rcode == NXDOMAIN)
+		section = ns_s_ns;
+	else
+		return;
+	if ((keylen = res_cache_key(buf, buflen, key)) == 0 ||
+	    ns_initparse(ans, anslen, &handle) < 0)
+		return;
+	for (i = 0; i < ns_msg_count(handle, section); i++) {
+		if (ns_parserr(&handle, section, i, &rr) < 0)
+			return;
+		if (section == ns_s_an) {
+			if (ns_rr_ttl(rr) < ttl)
+				ttl = ns_rr_ttl(rr);
+			found = 1;
+		} else if (ns_rr_type(rr) == ns_t_soa &&
+			   ns_rr_rdlen(rr) >= INT32SZ) {
+			/* MINIMUM is the last field of the SOA RDATA. */
+			minimum = ns_get32(ns_rr_rdata(rr) + ns_rr_rdlen(rr)
+					   - INT32SZ);
+			if (ns_rr_ttl(rr) < ttl)
+				ttl = ns_rr_ttl(rr);
+			if (minimum < ttl)
+				ttl = minimum;
+			found = 1;
+		}
+	}
+	if (!found || ttl == 0 || (copy = malloc(anslen)) == NULL)
+		return;
+	memcpy(copy, ans, anslen);
+
+	ent = res_cache_slot(key, keylen);
+	evNowTime(&now);
+	__libc_lock_lock (res_cache_lock);
+	old = ent->ans;
+	ent->keylen = keylen;
+	memcpy(ent->key, key, keylen);
+	ent->stored = now.tv_sec;
+	ent->expires = now.tv_sec + ttl;
+	ent->anslen = anslen;
+	ent->ans = copy;
+	__libc_lock_unlock (res_cache_lock);
+	free(old);
+}
+
 /* Public. */
 
 /* int
@@ -333,7 +527,7 @@ int
 __libc_res_nsend(res_state statp, const u_char *buf, int buflen,
 		 u_char *ans, int anssiz, u_char **ansp)
 {
-	int gotsomewhere, terrno, try, v_circuit, resplen, ns, n;
+	int gotsomewhere, terrno, try, v_circuit, resplen, ns, n, use_cache;
 
 	if (statp->nscount == 0) {
 		__set_errno (ESRCH);
@@ -355,6 +549,11 @@ __libc_res_nsend(res_state statp, const u_char *buf, int buflen,
 		anssiz = MAXPACKET;
 	}
 
+	use_cache = ((statp->options & RES_CACHE) != 0 &&
+		     statp->qhook == NULL && statp->rhook == NULL);
+	if (use_cache && (n = res_cache_get(buf, buflen, ans, anssiz)) > 0)
+		return (n);
+
 	DprintQ((statp->options & RES_DEBUG) || (statp->pfcode & RES_PRF_QUERY),
 		(stdout, ";; res_send()\n"), buf, buflen);
 	v_circuit = (statp->options & RES_USEVC) || buflen > PACKETSZ;
@@ -587,6 +786,8 @@ __libc_res_nsend(res_state statp, const u_char *buf, int buflen,
 			} while (!done);
 
 		}
+		if (use_cache && resplen <= anssiz)
+			res_cache_put(buf, buflen, ans, resplen);
 		return (resplen);
  next_ns: ;
 	   } /*foreach ns*/
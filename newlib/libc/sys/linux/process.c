@@ -6,10 +6,12 @@
 #include <sys/unistd.h>
 #include <sys/wait.h>
 #include <machine/syscall.h>
+#include "../../stdlib/local.h"
 
 
 #define __NR__exit __NR_exit
 #define __NR__execve __NR_execve
+#define __NR__fork __NR_fork
 
 _syscall0(int,getpid)
 _syscall0(pid_t,getppid)
@@ -18,7 +20,20 @@ weak_alias(__libc_getpid,__getpid);
 
 #if !defined(_ELIX_LEVEL) || _ELIX_LEVEL >= 3
 _syscall3(int,_execve,const char *,file,char * const *,argv,char * const *,envp)
-_syscall0(int,fork)
+_syscall0_base(int,_fork)
+
+/* linuxthreads' fork calls this too.  */
+int
+__libc_fork (void)
+{
+  int pid = __libc__fork ();
+
+  /* The child has a copy of the parent's arc4random state.  */
+  if (pid == 0)
+    _arc4random_fork_child ();
+  return pid;
+}
+weak_alias(__libc_fork,fork);
 #endif /* _ELIX_LEVEL >= 3 */
 
 #if !defined(_ELIX_LEVEL) || _ELIX_LEVEL >= 4
@@ -46,6 +46,143 @@
 
 #include "xdr_private.h"
 
+/* word order of a 64-bit item in memory, as 32-bit halves */
+#if BYTE_ORDER == LITTLE_ENDIAN
+# define XDR_HI 1
+# define XDR_LO 0
+#else
+# define XDR_HI 0
+# define XDR_LO 1
+#endif
+
+/* largest run handed to a single XDR_INLINE request, in words; small
+   enough to fit an xdrrec buffer and to keep xdr_sizeof's scratch
+   allocation modest */
+#define XDR_BULK_MAX ((u_int) 256)
+
+/*
+ * Element procedures whose external form is just one or two XDR units
+ * per element, taken straight from the element's bits.  Returns the
+ * number of 32-bit words per element, or 0 if elproc must be called
+ * for each element.  elsize must match the native size, so elements
+ * are contiguous.
+ */
+static int
+_DEFUN (xdr_bulk_words, (elproc, elsize),
+        xdrproc_t elproc _AND
+        u_int elsize)
+{
+  if (elsize == sizeof (int32_t))
+    {
+      if (elproc == (xdrproc_t) xdr_int32_t
+          || elproc == (xdrproc_t) xdr_uint32_t
+          || elproc == (xdrproc_t) xdr_u_int32_t
+#if defined(__IEEE_LITTLE_ENDIAN) || defined(__IEEE_BIG_ENDIAN)
+          || elproc == (xdrproc_t) xdr_float
+#endif
+          || (sizeof (int) == sizeof (int32_t)
+              && (elproc == (xdrproc_t) xdr_int
+                  || elproc == (xdrproc_t) xdr_u_int)))
+        return 1;
+      return 0;
+    }
+#if defined(___int64_t_defined)
+  if (elsize == sizeof (int64_t))
+    {
+      if (elproc == (xdrproc_t) xdr_int64_t
+          || elproc == (xdrproc_t) xdr_uint64_t
+          || elproc == (xdrproc_t) xdr_u_int64_t
+          || elproc == (xdrproc_t) xdr_hyper
+          || elproc == (xdrproc_t) xdr_u_hyper
+          || elproc == (xdrproc_t) xdr_longlong_t
+          || elproc == (xdrproc_t) xdr_u_longlong_t
+#if !defined(_DOUBLE_IS_32BITS) && \
+    ((defined(__IEEE_BIG_ENDIAN) && BYTE_ORDER == BIG_ENDIAN) || \
+     (defined(__IEEE_LITTLE_ENDIAN) && BYTE_ORDER == LITTLE_ENDIAN))
+          || elproc == (xdrproc_t) xdr_double
+#endif
+          )
+        return 2;
+    }
+#endif /* ___int64_t_defined */
+  return 0;
+}
+
+/*
+ * Code nelem elements of words XDR units each.  Runs are byte-swapped
+ * directly into or out of the stream buffer via XDR_INLINE.  The first
+ * time the stream cannot provide a run (xdrstdio never can, xdrrec not
+ * across a fragment), the rest of the array goes one element at a time
+ * through XDR_PUTINT32/XDR_GETINT32, without probing again.
+ */
+static bool_t
+_DEFUN (xdr_bulk, (xdrs, basep, nelem, words),
+        XDR * xdrs _AND
+        char *basep _AND
+        u_int nelem _AND
+        int words)
+{
+  int32_t *p = (int32_t *) (void *) basep;
+  int32_t *buf;
+  u_int n = nelem * words;
+  u_int run, i;
+
+  if (xdrs->x_op == XDR_FREE)
+    return TRUE;
+
+  while (n > 0)
+    {
+      run = (n < XDR_BULK_MAX) ? n : XDR_BULK_MAX;
+      buf = XDR_INLINE (xdrs, run * BYTES_PER_XDR_UNIT);
+      if (buf == NULL)
+        break;
+      if (words == 1)
+        {
+          if (xdrs->x_op == XDR_ENCODE)
+            for (i = 0; i < run; i++)
+              buf[i] = (int32_t) xdr_htonl ((uint32_t) p[i]);
+          else
+            for (i = 0; i < run; i++)
+              p[i] = (int32_t) xdr_ntohl ((uint32_t) buf[i]);
+        }
+      else
+        {
+          if (xdrs->x_op == XDR_ENCODE)
+            for (i = 0; i < run; i += 2)
+              {
+                buf[i] = (int32_t) xdr_htonl ((uint32_t) p[i + XDR_HI]);
+                buf[i + 1] = (int32_t) xdr_htonl ((uint32_t) p[i + XDR_LO]);
+              }
+          else
+            for (i = 0; i < run; i += 2)
+              {
+                p[i + XDR_HI] = (int32_t) xdr_ntohl ((uint32_t) buf[i]);
+                p[i + XDR_LO] = (int32_t) xdr_ntohl ((uint32_t) buf[i + 1]);
+              }
+        }
+      p += run;
+      n -= run;
+    }
+
+  for (; n > 0; p += words, n -= words)
+    {
+      if (words == 1)
+        {
+          if (!(xdrs->x_op == XDR_ENCODE ? XDR_PUTINT32 (xdrs, p)
+                                         : XDR_GETINT32 (xdrs, p)))
+            return FALSE;
+        }
+      else
+        {
+          if (!(xdrs->x_op == XDR_ENCODE
+                ? XDR_PUTINT32 (xdrs, p + XDR_HI) && XDR_PUTINT32 (xdrs, p + XDR_LO)
+                : XDR_GETINT32 (xdrs, p + XDR_HI) && XDR_GETINT32 (xdrs, p + XDR_LO)))
+            return FALSE;
+        }
+    }
+  return TRUE;
+}
+
 /*
  * XDR an array of arbitrary elements
  * *addrp is a pointer to the array, *sizep is the number of elements.
@@ -67,6 +204,7 @@ _DEFUN (xdr_array, (xdrs, addrp, sizep, maxsize, elsize, elproc),
   u_int c;                      /* the actual element count */
   bool_t stat = TRUE;
   u_int nodesize;
+  int words;
 
   /* like strings, arrays are really counted arrays */
   if (!xdr_u_int (xdrs, sizep))
@@ -110,11 +248,15 @@ _DEFUN (xdr_array, (xdrs, addrp, sizep, maxsize, elsize, elproc),
   /*
    * now we xdr each element of array
    */
-  for (i = 0; (i < c) && stat; i++)
-    {
-      stat = (*elproc) (xdrs, target);
-      target += elsize;
-    }
+  words = xdr_bulk_words (elproc, elsize);
+  if (words != 0)
+    stat = xdr_bulk (xdrs, target, c, words);
+  else
+    for (i = 0; (i < c) && stat; i++)
+      {
+        stat = (*elproc) (xdrs, target);
+        target += elsize;
+      }
 
   /*
    * the array may need freeing
@@ -147,6 +289,11 @@ _DEFUN (xdr_vector, (xdrs, basep, nelem, elemsize, xdr_elem),
 {
   u_int i;
   char *elptr;
+  int words;
+
+  words = xdr_bulk_words (xdr_elem, elemsize);
+  if (words != 0 && nelem <= UINT_MAX / elemsize)
+    return xdr_bulk (xdrs, basep, nelem, words);
 
   elptr = basep;
   for (i = 0; i < nelem; i++)
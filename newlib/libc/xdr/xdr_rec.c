@@ -124,6 +124,8 @@ typedef struct rec_strm
   caddr_t out_boundry;          /* data cannot up to this address */
   u_int32_t *frag_header;       /* beginning of curren fragment */
   bool_t frag_sent;             /* true if buffer sent in middle of record */
+  int (*writevit) (void *, _CONST struct xdr_iovec *, int);
+  u_int writev_min;             /* putbytes of this size or more bypass */
   /*
    * in-coming bits
    */
@@ -155,6 +157,9 @@ static bool_t get_input_bytes (RECSTREAM *, char *, size_t);
 static bool_t set_input_fragment (RECSTREAM *);
 static bool_t skip_input_bytes (RECSTREAM *, long);
 static bool_t realloc_stream (RECSTREAM *, int);
+static bool_t flush_out_with (RECSTREAM *, _CONST char *, u_int);
+static bool_t get_input_direct (RECSTREAM *, char *, size_t);
+static bool_t compact_input_buf (RECSTREAM *, size_t);
 
 bool_t _EXFUN (__xdrrec_getrec, (XDR *, enum xprt_stat *, bool_t));
 bool_t _EXFUN (__xdrrec_setnonblock, (XDR *, int));
@@ -241,6 +246,8 @@ _DEFUN (xdrrec_create, (xdrs, sendsize, recvsize, tcp_handle, readit, writeit),
   rstrm->out_finger += sizeof (u_int32_t);
   rstrm->out_boundry += sendsize;
   rstrm->frag_sent = FALSE;
+  rstrm->writevit = NULL;
+  rstrm->writev_min = 0;
   rstrm->in_size = recvsize;
   rstrm->in_boundry = rstrm->in_base;
   rstrm->in_finger = (rstrm->in_boundry += recvsize);
@@ -351,6 +358,17 @@ _DEFUN (xdrrec_putbytes, (xdrs, addr, len),
   RECSTREAM *rstrm = (RECSTREAM *) (xdrs->x_private);
   size_t current;
 
+  /* Large items are handed to a gather-capable transport as a second
+   * iovec behind the bytes already buffered, so they are never copied
+   * into out_base.  Both parts travel as a single (non-final) fragment.
+   */
+  if (rstrm->writevit != NULL && len >= rstrm->writev_min &&
+      len < LAST_FRAG - rstrm->sendsize)
+    {
+      rstrm->frag_sent = TRUE;
+      return flush_out_with (rstrm, addr, len);
+    }
+
   while (len > 0)
     {
       current = (size_t) ((u_long) rstrm->out_boundry -
@@ -548,6 +566,61 @@ _DEFUN (xdrrec_putint32, (xdrs, ip),
  * Exported routines to manage xdr records
  */
 
+/*
+ * Enable scatter/gather output.  Whenever a single putbytes request
+ * (xdr_opaque, xdr_bytes, xdr_string payloads) is at least minsize
+ * bytes long, the stream sends the buffered fragment prefix and the
+ * caller's bytes together through writevit instead of copying them
+ * into the send buffer.  writevit has writev semantics: it returns the
+ * total number of bytes written, or -1.  A NULL writevit turns the
+ * feature off again.  minsize 0 selects the send buffer size.
+ */
+void
+_DEFUN (xdrrec_setwritev, (xdrs, writevit, minsize),
+        XDR * xdrs _AND
+        int _EXPARM (writevit, (void *, _CONST struct xdr_iovec *, int)) _AND
+        u_int minsize)
+{
+  RECSTREAM *rstrm = (RECSTREAM *) (xdrs->x_private);
+
+  rstrm->writevit = writevit;
+  rstrm->writev_min = (minsize == 0) ? rstrm->sendsize : minsize;
+}
+
+/*
+ * Borrow the next len bytes of the current fragment in place.
+ * Returns a pointer into the receive buffer and consumes the bytes, or
+ * NULL if they cannot be presented contiguously: len crosses the end
+ * of the fragment, or exceeds the receive buffer.  In that case nothing
+ * is consumed and the caller should fall back to XDR_GETBYTES.  The
+ * pointer stays valid until the next operation on xdrs.
+ */
+caddr_t
+_DEFUN (xdrrec_borrowbytes, (xdrs, len),
+        XDR * xdrs _AND
+        u_int len)
+{
+  RECSTREAM *rstrm = (RECSTREAM *) (xdrs->x_private);
+  caddr_t buf;
+
+  if (xdrs->x_op != XDR_DECODE)
+    return NULL;
+  while (rstrm->fbtbc == 0)
+    {
+      if (rstrm->last_frag || !set_input_fragment (rstrm))
+        return NULL;
+    }
+  if ((long) len > rstrm->fbtbc)
+    return NULL;
+  if ((size_t) (rstrm->in_boundry - rstrm->in_finger) < len
+      && !compact_input_buf (rstrm, len))
+    return NULL;
+  buf = rstrm->in_finger;
+  rstrm->in_finger += len;
+  rstrm->fbtbc -= len;
+  return buf;
+}
+
 /*
  * Before reading (deserializing from the stream, one should always call
  * this procedure to guarantee proper record alignment.
@@ -774,6 +847,36 @@ _DEFUN (flush_out, (rstrm, eor),
   return TRUE;
 }
 
+/*
+ * Like flush_out (rstrm, FALSE), but the fragment carries len extra
+ * bytes at addr, written straight from the caller's memory.
+ */
+static bool_t
+_DEFUN (flush_out_with, (rstrm, addr, len),
+        RECSTREAM * rstrm _AND
+        _CONST char *addr _AND
+        u_int len)
+{
+  struct xdr_iovec iov[2];
+  u_int32_t fraglen = (u_int32_t) ((u_long) (rstrm->out_finger) -
+                                   (u_long) (rstrm->frag_header) -
+                                   sizeof (u_int32_t)) + len;
+  int total;
+
+  *(rstrm->frag_header) = htonl (fraglen);
+  iov[0].iov_base = rstrm->out_base;
+  iov[0].iov_len = (size_t) ((u_long) (rstrm->out_finger) -
+                             (u_long) (rstrm->out_base));
+  iov[1].iov_base = (void *) addr;
+  iov[1].iov_len = len;
+  total = (int) (iov[0].iov_len + iov[1].iov_len);
+  if ((*(rstrm->writevit)) (rstrm->tcp_handle, iov, 2) != total)
+    return FALSE;
+  rstrm->frag_header = (u_int32_t *) (void *) rstrm->out_base;
+  rstrm->out_finger = (char *) rstrm->out_base + sizeof (u_int32_t);
+  return TRUE;
+}
+
 static bool_t                   /* knows nothing about records!  Only about input buffers */
 _DEFUN (fill_input_buf, (rstrm),
         RECSTREAM * rstrm)
@@ -820,6 +923,10 @@ _DEFUN (get_input_bytes, (rstrm, addr, len),
       current = (size_t) ((long) rstrm->in_boundry - (long) rstrm->in_finger);
       if (current == 0)
         {
+          /* Reading a whole buffer's worth would only stage it in
+           * in_base for us to copy out again; read it in place.  */
+          if (len >= rstrm->in_size)
+            return get_input_direct (rstrm, addr, len);
           if (!fill_input_buf (rstrm))
             return FALSE;
           continue;
@@ -833,6 +940,59 @@ _DEFUN (get_input_bytes, (rstrm, addr, len),
   return TRUE;
 }
 
+static bool_t                   /* knows nothing about records!  Only about input buffers */
+_DEFUN (get_input_direct, (rstrm, addr, len),
+        RECSTREAM * rstrm _AND
+        char *addr _AND
+        size_t len)
+{
+  u_int32_t i;
+  int n;
+
+  /* the input buffer is empty; keep fill_input_buf's invariant that
+   * (in_boundry % BYTES_PER_XDR_UNIT) tracks the stream position */
+  i = (u_int32_t) (((u_long) rstrm->in_boundry + len) % BYTES_PER_XDR_UNIT);
+  while (len > 0)
+    {
+      n = (*(rstrm->readit)) (rstrm->tcp_handle, addr,
+                              (len > INT_MAX) ? INT_MAX : (int) len);
+      if (n <= 0)
+        return FALSE;
+      addr += n;
+      len -= n;
+    }
+  rstrm->in_finger = rstrm->in_boundry = rstrm->in_base + i;
+  return TRUE;
+}
+
+static bool_t                   /* make len bytes contiguous at in_finger */
+_DEFUN (compact_input_buf, (rstrm, len),
+        RECSTREAM * rstrm _AND
+        size_t len)
+{
+  size_t have = (size_t) (rstrm->in_boundry - rstrm->in_finger);
+  u_int32_t i = (u_int32_t) ((u_long) rstrm->in_finger % BYTES_PER_XDR_UNIT);
+  char *where;
+  int n;
+
+  if (rstrm->nonblock || len + i > rstrm->in_size)
+    return FALSE;
+  where = rstrm->in_base + i;
+  memmove (where, rstrm->in_finger, have);
+  rstrm->in_finger = where;
+  rstrm->in_boundry = where + have;
+  while (have < len)
+    {
+      n = (*(rstrm->readit)) (rstrm->tcp_handle, rstrm->in_boundry,
+                              (int) (rstrm->in_size - i - have));
+      if (n <= 0)
+        return FALSE;
+      rstrm->in_boundry += n;
+      have += n;
+    }
+  return TRUE;
+}
+
 static bool_t                   /* next two bytes of the input stream are treated as a header */
 _DEFUN (set_input_fragment, (rstrm),
         RECSTREAM * rstrm)
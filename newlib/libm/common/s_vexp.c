@@ -0,0 +1,164 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/*
+FUNCTION
+	<<vexp>>, <<vlog>>, <<vsin>>, <<vcos>>, <<vsqrt>>, <<vpow>>, <<vtanh>>, <<vsincos>>, <<vcexp>>---elementary functions over arrays
+INDEX
+	vexp
+INDEX
+	vexpf
+INDEX
+	vlog
+INDEX
+	vlogf
+INDEX
+	vsin
+INDEX
+	vsinf
+INDEX
+	vcos
+INDEX
+	vcosf
+INDEX
+	vsqrt
+INDEX
+	vsqrtf
+INDEX
+	vpow
+INDEX
+	vpowf
+INDEX
+	vtanh
+INDEX
+	vtanhf
+INDEX
+	vsincos
+INDEX
+	vsincosf
+INDEX
+	vcexp
+INDEX
+	vcexpf
+
+ANSI_SYNOPSIS
+	#define _ARRAY_MATH_SOURCE
+	#include <math.h>
+	void vexp(double *<[out]>, const double *<[in]>, size_t <[n]>);
+	void vexpf(float *<[out]>, const float *<[in]>, size_t <[n]>);
+	void vlog(double *<[out]>, const double *<[in]>, size_t <[n]>);
+	void vlogf(float *<[out]>, const float *<[in]>, size_t <[n]>);
+	void vsin(double *<[out]>, const double *<[in]>, size_t <[n]>);
+	void vsinf(float *<[out]>, const float *<[in]>, size_t <[n]>);
+	void vcos(double *<[out]>, const double *<[in]>, size_t <[n]>);
+	void vcosf(float *<[out]>, const float *<[in]>, size_t <[n]>);
+	void vsqrt(double *<[out]>, const double *<[in]>, size_t <[n]>);
+	void vsqrtf(float *<[out]>, const float *<[in]>, size_t <[n]>);
+	void vpow(double *<[out]>, const double *<[x]>, const double *<[y]>,
+	          size_t <[n]>);
+	void vpowf(float *<[out]>, const float *<[x]>, const float *<[y]>,
+	           size_t <[n]>);
+	void vtanh(double *<[out]>, const double *<[in]>, size_t <[n]>);
+	void vtanhf(float *<[out]>, const float *<[in]>, size_t <[n]>);
+	void vsincos(double *<[s]>, double *<[c]>, const double *<[in]>,
+	             size_t <[n]>);
+	void vsincosf(float *<[s]>, float *<[c]>, const float *<[in]>,
+	              size_t <[n]>);
+
+	#define _ARRAY_MATH_SOURCE
+	#include <complex.h>
+	void vcexp(double complex *<[out]>, const double complex *<[in]>,
+	           size_t <[n]>);
+	void vcexpf(float complex *<[out]>, const float complex *<[in]>,
+	            size_t <[n]>);
+
+TRAD_SYNOPSIS
+	#define _ARRAY_MATH_SOURCE
+	#include <math.h>
+	void vexp(<[out]>, <[in]>, <[n]>);
+	double *<[out]>;
+	double *<[in]>;
+	size_t <[n]>;
+
+	void vpow(<[out]>, <[x]>, <[y]>, <[n]>);
+	double *<[out]>;
+	double *<[x]>;
+	double *<[y]>;
+	size_t <[n]>;
+
+DESCRIPTION
+	Each of these functions applies the function of the same name
+	without the leading <<v>> to the <[n]> elements of <[in]> and
+	stores the results in the first <[n]> elements of <[out]>;
+	<<vpow>> and <<vpowf>> compute <<pow>>(<[x]>[i], <[y]>[i]),
+	and <<vsincos>> and <<vsincosf>> store <<sincos>>(<[in]>[i])
+	in <[s]>[i] and <[c]>[i].
+	<[out]> may be the same array as an input, but must not
+	otherwise overlap one.
+
+	When compiled for SSE2, AVX2 or AArch64 NEON, the functions
+	work on two or four elements at a time in double precision.
+	The results of <<vexp>>, <<vlog>>, <<vsin>>, <<vcos>> and
+	<<vpow>> are then within 1 ulp of the exact value, and those of
+	<<vtanh>> within 1.5 ulp; the float functions round a double
+	result, and so are correctly rounded in nearly all cases.
+	<<vsqrt>> and <<vsqrtf>> are exact.  Zeros, infinities, NaNs,
+	subnormal arguments to the logarithms, and arguments outside
+	each kernel's range (beyond 708 for <<vexp>>, beyond 1.6e6 for
+	<<vsin>> and <<vcos>>, or where <<vpow>> would overflow,
+	underflow or fail) are passed to the scalar function, so those
+	results and every change to <<errno>> are the same as calling
+	it on each element in turn.  <<vsincos>> and <<vsincosf>> use
+	the sine and cosine kernels, and <<vcexp>> and <<vcexpf>>
+	multiply those by the exponential, so each part of a complex
+	result is within 2 ulp.  On other targets every function calls
+	the scalar function for each element.
+
+RETURNS
+	These functions do not return a value.
+
+PORTABILITY
+	These functions are newlib extensions.  Since their names are
+	not reserved, <<math.h>> declares them only when
+	<<_ARRAY_MATH_SOURCE>> is defined before it is included.
+
+*/
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifndef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vexp(double *out, const double *in, size_t n)
+#else
+	void vexp(out, in, n)
+	double *out;
+	const double *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN)
+    {
+      x = v_load (in);
+      special = ~(v_s64) (v_abs (x) <= 708.0);
+      v_store (out, v_exp (v_fill (special, x, 0.0)));
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = exp (x[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = exp (*in++);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
@@ -0,0 +1,47 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifndef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vpow(double *out, const double *x, const double *y, size_t n)
+#else
+	void vpow(out, x, y, n)
+	double *out;
+	const double *x;
+	const double *y;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 vx, vy, z;
+  v_s64 special, big;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, x += V_LEN, y += V_LEN, out += V_LEN)
+    {
+      vx = v_load (x);
+      vy = v_load (y);
+      special = ((v_s64) (vx < 2.2250738585072014e-308)
+		 | (v_s64) (vx > 1.7976931348623157e+308) | (v_s64) (vx != vx)
+		 | (v_s64) (v_abs (vy) > 2147483648.0) | (v_s64) (vy != vy));
+      z = v_pow (v_fill (special, vx, 1.0), v_fill (special, vy, 0.0), &big);
+      special |= big;
+      v_store (out, z);
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = pow (vx[i], vy[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = pow (*x++, *y++);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
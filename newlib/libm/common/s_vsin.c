@@ -0,0 +1,42 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifndef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vsin(double *out, const double *in, size_t n)
+#else
+	void vsin(out, in, n)
+	double *out;
+	const double *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x, s, c;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN)
+    {
+      x = v_load (in);
+      special = ~(v_s64) (v_abs (x) <= 1.6e6);
+      special |= v_sincos (v_fill (special, x, 0.0), &s, &c);
+      v_store (out, s);
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = sin (x[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = sin (*in++);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
@@ -0,0 +1,54 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifdef __STDC__
+	void vcosf(float *out, const float *in, size_t n)
+#else
+	void vcosf(out, in, n)
+	float *out;
+	const float *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x, s, c;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN)
+    {
+      x = v_loadf (in);
+      special = ~(v_s64) (v_abs (x) <= 1.6e6);
+      special |= v_sincos (v_fill (special, x, 0.0), &s, &c);
+      v_storef (out, c);
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = cosf ((float) x[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = cosf (*in++);
+}
+
+#ifdef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vcos(double *out, const double *in, size_t n)
+#else
+	void vcos(out, in, n)
+	double *out;
+	const double *in;
+	size_t n;
+#endif
+{
+  vcosf ((float *) out, (const float *) in, n);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
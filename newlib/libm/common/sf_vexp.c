@@ -0,0 +1,53 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifdef __STDC__
+	void vexpf(float *out, const float *in, size_t n)
+#else
+	void vexpf(out, in, n)
+	float *out;
+	const float *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN)
+    {
+      x = v_loadf (in);
+      special = ~(v_s64) (v_abs (x - 0.5) <= 87.5);	/* -87 to 88 */
+      v_storef (out, v_exp (v_fill (special, x, 0.0)));
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = expf ((float) x[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = expf (*in++);
+}
+
+#ifdef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vexp(double *out, const double *in, size_t n)
+#else
+	void vexp(out, in, n)
+	double *out;
+	const double *in;
+	size_t n;
+#endif
+{
+  vexpf ((float *) out, (const float *) in, n);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
@@ -0,0 +1,54 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifdef __STDC__
+	void vlogf(float *out, const float *in, size_t n)
+#else
+	void vlogf(out, in, n)
+	float *out;
+	const float *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN)
+    {
+      x = v_loadf (in);
+      special = ((v_s64) (x < 1.17549435082228750797e-38)
+		 | (v_s64) (x > 3.40282346638528859812e+38) | (v_s64) (x != x));
+      v_storef (out, v_log (v_fill (special, x, 1.0)));
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = logf ((float) x[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = logf (*in++);
+}
+
+#ifdef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vlog(double *out, const double *in, size_t n)
+#else
+	void vlog(out, in, n)
+	double *out;
+	const double *in;
+	size_t n;
+#endif
+{
+  vlogf ((float *) out, (const float *) in, n);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
@@ -0,0 +1,63 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifdef __STDC__
+	void vpowf(float *out, const float *x, const float *y, size_t n)
+#else
+	void vpowf(out, x, y, n)
+	float *out;
+	const float *x;
+	const float *y;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 vx, vy, z;
+  v_s64 special, big;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, x += V_LEN, y += V_LEN, out += V_LEN)
+    {
+      vx = v_loadf (x);
+      vy = v_loadf (y);
+      special = ((v_s64) (vx < 1.17549435082228750797e-38)
+		 | (v_s64) (vx > 3.40282346638528859812e+38) | (v_s64) (vx != vx)
+		 | (v_s64) (v_abs (vy) > 2147483648.0) | (v_s64) (vy != vy));
+      z = v_pow (v_fill (special, vx, 1.0), v_fill (special, vy, 0.0), &big);
+      special |= big;
+      /* The result must be a normal float as well.  */
+      special |= ((v_s64) (z < 1.17549435082228750797e-38)
+		  | (v_s64) (z > 3.40282346638528859812e+38));
+      v_storef (out, z);
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = powf ((float) vx[i], (float) vy[i]);
+    }
+#endif
+  while (n-- > 0)
+    *out++ = powf (*x++, *y++);
+}
+
+#ifdef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vpow(double *out, const double *x, const double *y, size_t n)
+#else
+	void vpow(out, x, y, n)
+	double *out;
+	const double *x;
+	const double *y;
+	size_t n;
+#endif
+{
+  vpowf ((float *) out, (const float *) x, (const float *) y, n);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
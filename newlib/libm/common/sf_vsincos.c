@@ -0,0 +1,58 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _GNU_SOURCE
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifdef __STDC__
+	void vsincosf(float *s, float *c, const float *in, size_t n)
+#else
+	void vsincosf(s, c, in, n)
+	float *s;
+	float *c;
+	const float *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x, vs, vc;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, s += V_LEN, c += V_LEN)
+    {
+      x = v_loadf (in);
+      special = ~(v_s64) (v_abs (x) <= 1.6e6);
+      special |= v_sincos (v_fill (special, x, 0.0), &vs, &vc);
+      v_storef (s, vs);
+      v_storef (c, vc);
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    sincosf ((float) x[i], &s[i], &c[i]);
+    }
+#endif
+  while (n-- > 0)
+    sincosf (*in++, s++, c++);
+}
+
+#ifdef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vsincos(double *s, double *c, const double *in, size_t n)
+#else
+	void vsincos(s, c, in, n)
+	double *s;
+	double *c;
+	const double *in;
+	size_t n;
+#endif
+{
+  vsincosf ((float *) s, (float *) c, (const float *) in, n);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
@@ -0,0 +1,59 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include "fdlibm.h"
+#include "v_math.h"
+
+#ifdef __STDC__
+	void vsqrtf(float *out, const float *in, size_t n)
+#else
+	void vsqrtf(out, in, n)
+	float *out;
+	const float *in;
+	size_t n;
+#endif
+{
+#ifdef V_LEN
+  v_f64 x;
+  v_s64 special;
+  int i;
+
+  for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN)
+    {
+      x = v_loadf (in);
+      special = ~(v_s64) (x >= 0.0);
+      v_storef (out, V_SQRT (v_fill (special, x, 0.0)));
+      if (v_any (special))
+	for (i = 0; i < V_LEN; i++)
+	  if (special[i])
+	    out[i] = sqrtf ((float) x[i]);
+    }
+#endif
+  while (n-- > 0)
+#ifdef __GNUC__
+    /* Inline where the target has a square root instruction; GCC
+       still calls sqrtf for a negative argument, so errno is set.  */
+    *out++ = __builtin_sqrtf (*in++);
+#else
+    *out++ = sqrtf (*in++);
+#endif
+}
+
+#ifdef _DOUBLE_IS_32BITS
+
+#ifdef __STDC__
+	void vsqrt(double *out, const double *in, size_t n)
+#else
+	void vsqrt(out, in, n)
+	double *out;
+	const double *in;
+	size_t n;
+#endif
+{
+  vsqrtf ((float *) out, (const float *) in, n);
+}
+
+#endif /* defined(_DOUBLE_IS_32BITS) */
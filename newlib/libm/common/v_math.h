@@ -0,0 +1,401 @@
+/* Vector kernels for the array math functions.
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+
+/* Before including this file, you need to include "fdlibm.h".
+
+  If the target has a suitable vector unit, this file defines V_LEN,
+  the number of doubles in a vector, and the kernels below; otherwise
+  it defines nothing, and callers should loop over the scalar functions.
+
+  The kernels are the fdlibm algorithms for a restricted range of
+  arguments, written with GCC's generic vector types so that the same
+  code becomes SSE2 or AVX2 on x86 and NEON on aarch64.  The caller
+  checks the range: lanes outside it get unspecified values, and must
+  be recomputed with the scalar function, which also sets errno.
+  Float functions widen to double and use the same kernels.
+*/
+
+#if (defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)
+# if defined(__AVX2__)
+#  include <immintrin.h>
+#  define V_LEN 4
+#  define V_SQRT(x) ((v_f64) _mm256_sqrt_pd ((__m256d) (x)))
+#  define V_LOADF(p) ((v_f64) _mm256_cvtps_pd (_mm_loadu_ps (p)))
+#  define V_STOREF(p, x) _mm_storeu_ps ((p), _mm256_cvtpd_ps ((__m256d) (x)))
+#  define V_ANY(m) (_mm256_movemask_pd ((__m256d) (m)) != 0)
+#  define V_SEL(m, a, b) \
+  ((v_f64) _mm256_blendv_pd ((__m256d) (b), (__m256d) (a), (__m256d) (m)))
+# elif defined(__SSE2__)
+#  include <emmintrin.h>
+#  define V_LEN 2
+#  define V_SQRT(x) ((v_f64) _mm_sqrt_pd ((__m128d) (x)))
+#  define V_LOADF(p) \
+  ((v_f64) _mm_cvtps_pd (_mm_loadl_pi (_mm_setzero_ps (), (const __m64 *) (p))))
+#  define V_STOREF(p, x) \
+  _mm_storel_pi ((__m64 *) (p), _mm_cvtpd_ps ((__m128d) (x)))
+#  define V_ANY(m) (_mm_movemask_pd ((__m128d) (m)) != 0)
+#  define V_SEL(m, a, b) \
+  ((v_f64) _mm_or_pd (_mm_and_pd ((__m128d) (m), (__m128d) (a)), \
+		      _mm_andnot_pd ((__m128d) (m), (__m128d) (b))))
+# elif defined(__ARM_NEON) && defined(__aarch64__)
+#  include <arm_neon.h>
+#  define V_LEN 2
+#  define V_SQRT(x) ((v_f64) vsqrtq_f64 ((float64x2_t) (x)))
+#  define V_LOADF(p) ((v_f64) vcvt_f64_f32 (vld1_f32 (p)))
+#  define V_STOREF(p, x) vst1_f32 ((p), vcvt_f32_f64 ((float64x2_t) (x)))
+#  define V_ANY(m) (vmaxvq_u32 ((uint32x4_t) (m)) != 0)
+#  define V_SEL(m, a, b) \
+  ((v_f64) vbslq_f64 ((uint64x2_t) (m), (float64x2_t) (a), (float64x2_t) (b)))
+# endif
+#endif
+
+#ifdef V_LEN
+
+typedef double v_f64 __attribute__ ((vector_size (V_LEN * 8)));
+typedef __int64_t v_s64 __attribute__ ((vector_size (V_LEN * 8)));
+typedef __uint64_t v_u64 __attribute__ ((vector_size (V_LEN * 8)));
+
+/* Adding this rounds a double below 2**51 in magnitude to an integer,
+   which is then in the low bits of the sum.  */
+#define V_SHIFT		6755399441055744.0	/* 0x43380000, 0x00000000 */
+#define V_SHIFT_BITS	0x4338000000000000LL
+#define V_SIGN		(-0x7fffffffffffffffLL - 1)
+#define V_HIGH		(-0x100000000LL)	/* high word mask */
+
+static inline v_f64
+v_load (const double *p)
+{
+  v_f64 v;
+
+  __builtin_memcpy (&v, p, sizeof v);
+  return v;
+}
+
+static inline void
+v_store (double *p, v_f64 v)
+{
+  __builtin_memcpy (p, &v, sizeof v);
+}
+
+static inline v_f64
+v_loadf (const float *p)
+{
+  return V_LOADF (p);
+}
+
+static inline void
+v_storef (float *p, v_f64 v)
+{
+  V_STOREF (p, v);
+}
+
+/* Whether any lane of the mask M is set.  */
+static inline int
+v_any (v_s64 m)
+{
+  return V_ANY (m);
+}
+
+static inline v_f64
+v_dup (double c)
+{
+  return (v_f64) { 0 } + c;
+}
+
+/* M ? A : B, lane by lane.  */
+static inline v_f64
+v_sel (v_s64 m, v_f64 a, v_f64 b)
+{
+  return V_SEL (m, a, b);
+}
+
+/* X with the lanes in M set to C.  */
+static inline v_f64
+v_fill (v_s64 m, v_f64 x, double c)
+{
+  return v_sel (m, v_dup (c), x);
+}
+
+static inline v_f64
+v_abs (v_f64 x)
+{
+  return (v_f64) ((v_s64) x & ~V_SIGN);
+}
+
+/* X with its low word cleared.  */
+static inline v_f64
+v_trunc32 (v_f64 x)
+{
+  return (v_f64) ((v_s64) x & V_HIGH);
+}
+
+/* N, below 2**51 in magnitude, as a double.  */
+static inline v_f64
+v_cvt (v_s64 n)
+{
+  return (v_f64) (n + V_SHIFT_BITS) - V_SHIFT;
+}
+
+/* exp(X) for |X| <= 708, within 1 ulp; see e_exp.c.  */
+static inline v_f64
+v_exp (v_f64 x)
+{
+  const double
+    invln2 = 1.44269504088896338700e+00, /* 0x3ff71547, 0x652b82fe */
+    ln2HI  = 6.93147180369123816490e-01, /* 0x3fe62e42, 0xfee00000 */
+    ln2LO  = 1.90821492927058770002e-10, /* 0x3dea39ef, 0x35793c76 */
+    P1 =  1.66666666666666019037e-01, /* 0x3FC55555, 0x5555553E */
+    P2 = -2.77777777770155933842e-03, /* 0xBF66C16C, 0x16BEBD93 */
+    P3 =  6.61375632143793436117e-05, /* 0x3F11566A, 0xAF25DE2C */
+    P4 = -1.65339022054652515390e-06, /* 0xBEBBBD41, 0xC5D26BF1 */
+    P5 =  4.13813679705723846039e-08; /* 0x3E663769, 0x72BEA4D0 */
+  v_f64 k, hi, lo, r, t, c, y;
+  v_s64 ki;
+
+  /* x = k*ln2 + r, |r| <= 0.5*ln2; k*ln2HI is exact.  */
+  k = x * invln2 + V_SHIFT;
+  ki = (v_s64) k - V_SHIFT_BITS;
+  k -= V_SHIFT;
+  hi = x - k * ln2HI;
+  lo = k * ln2LO;
+  r = hi - lo;
+
+  t = r * r;
+  c = r - t * (P1 + t * (P2 + t * (P3 + t * (P4 + t * P5))));
+  y = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+  /* The result is normal, so add k to y's exponent.  */
+  return (v_f64) ((v_s64) y + (ki << 52));
+}
+
+/* log(X) for positive normal finite X, within 1 ulp; see e_log.c.  */
+static inline v_f64
+v_log (v_f64 x)
+{
+  const double
+    ln2_hi = 6.93147180369123816490e-01, /* 3fe62e42 fee00000 */
+    ln2_lo = 1.90821492927058770002e-10, /* 3dea39ef 35793c76 */
+    Lg1 = 6.666666666666735130e-01,  /* 3FE55555 55555593 */
+    Lg2 = 3.999999999940941908e-01,  /* 3FD99999 9997FA04 */
+    Lg3 = 2.857142874366239149e-01,  /* 3FD24924 94229359 */
+    Lg4 = 2.222219843214978396e-01,  /* 3FCC71C5 1D8E78AF */
+    Lg5 = 1.818357216161805012e-01,  /* 3FC74664 96CB03DE */
+    Lg6 = 1.531383769920937332e-01,  /* 3FC39A09 D078C69F */
+    Lg7 = 1.479819860511658591e-01;  /* 3FC2F112 DF3E5244 */
+  v_f64 f, s, z, w, R, hfsq, dk;
+  v_s64 hx, k, i;
+
+  /* x = 2**k * (1+f), sqrt(2)/2 < 1+f < sqrt(2).  The shifts are
+     logical, since SSE2 has no 64-bit arithmetic shift.  */
+  hx = (v_s64) ((v_u64) x >> 32);
+  k = (v_s64) ((v_u64) hx >> 20) - 1023;
+  hx &= 0x000fffff;
+  i = (hx + 0x95f64) & 0x100000;
+  x = (v_f64) (((v_s64) x & ~V_HIGH) | ((hx | (i ^ 0x3ff00000)) << 32));
+  k += (v_s64) ((v_u64) i >> 20);
+  f = x - 1.0;
+  dk = v_cvt (k);
+
+  s = f / (2.0 + f);
+  z = s * s;
+  w = z * z;
+  R = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)))
+      + w * (Lg2 + w * (Lg4 + w * Lg6));
+  /* e_log.c uses this form only near f = 0.4, but it is the more
+     accurate of its two everywhere.  */
+  hfsq = 0.5 * f * f;
+  return dk * ln2_hi - ((hfsq - (s * (hfsq + R) + dk * ln2_lo)) - f);
+}
+
+/* sin(X) in *S and cos(X) in *C for |X| <= 2**19*pi, within 1 ulp;
+   see e_rem_pio2.c, k_sin.c and k_cos.c.  Returns the lanes too close
+   to a multiple of pi/2 for the reduction here, which the caller must
+   recompute.  */
+static inline v_s64
+v_sincos (v_f64 x, v_f64 *sinp, v_f64 *cosp)
+{
+  const double
+    invpio2 = 6.36619772367581382433e-01, /* 0x3FE45F30, 0x6DC9C883 */
+    pio2_1  = 1.57079632673412561417e+00, /* 0x3FF921FB, 0x54400000 */
+    pio2_1t = 6.07710050650619224932e-11, /* 0x3DD0B461, 0x1A626331 */
+    S1 = -1.66666666666666324348e-01, /* 0xBFC55555, 0x55555549 */
+    S2 =  8.33333333332248946124e-03, /* 0x3F811111, 0x1110F8A6 */
+    S3 = -1.98412698298579493134e-04, /* 0xBF2A01A0, 0x19C161D5 */
+    S4 =  2.75573137070700676789e-06, /* 0x3EC71DE3, 0x57B1FE7D */
+    S5 = -2.50507602534068634195e-08, /* 0xBE5AE5E6, 0x8A2B9CEB */
+    S6 =  1.58969099521155010221e-10, /* 0x3DE5D93A, 0x5ACFD57C */
+    C1 =  4.16666666666666019037e-02, /* 0x3FA55555, 0x5555554C */
+    C2 = -1.38888888888741095749e-03, /* 0xBF56C16C, 0x16C15177 */
+    C3 =  2.48015872894767294178e-05, /* 0x3EFA01A0, 0x19CB1590 */
+    C4 = -2.75573143513906633035e-07, /* 0xBE927E4F, 0x809C52AD */
+    C5 =  2.08757232129817482790e-09, /* 0x3E21EE9E, 0xBDB4B1C4 */
+    C6 = -1.13596475577881948265e-11; /* 0xBDA8FAE9, 0xBE8838D4 */
+  v_f64 n, r, w, y0, y1, z, v, s, c, t;
+  v_s64 ni, m;
+
+  /* x = n*pi/2 + y0 + y1.  n*pio2_1 is exact, and the rest of n*pi/2
+     is good to |n|*2**-86, which is 0.07 ulp of y0 unless |y0| is
+     below |n|*2**-29.  */
+  n = x * invpio2 + V_SHIFT;
+  ni = (v_s64) n - V_SHIFT_BITS;
+  n -= V_SHIFT;
+  r = x - n * pio2_1;
+  w = n * pio2_1t;
+  y0 = r - w;
+  y1 = (r - y0) - w;
+
+  z = y0 * y0;
+  w = z * z;
+  v = z * y0;
+  t = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+  s = y0 - ((z * (0.5 * y1 - v * t) - y1) - v * S1);
+
+  t = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+  v = 0.5 * z;
+  w = 1.0 - v;
+  c = w + (((1.0 - w) - v) + (z * t - y0 * y1));
+
+  /* Quadrant n: sin, cos, -sin, -cos.  */
+  m = -(ni & 1);
+  t = v_sel (m, c, s);
+  c = v_sel (m, s, c);
+  *sinp = (v_f64) ((v_s64) t ^ ((ni & 2) << 62));
+  *cosp = (v_f64) ((v_s64) c ^ (((ni + 1) & 2) << 62));
+  return (v_s64) (v_abs (y0) < v_abs (n) * 1.86264514923095703125e-09);
+}
+
+/* tanh(X) for X not a NaN, within 1.5 ulp.  */
+static inline v_f64
+v_tanh (v_f64 x)
+{
+  /* tanh(x) = x + x*z*D(z)/P(z), z = x*x, for |x| < 0.75: the tenth
+     convergent of Lambert's continued fraction, good to 1e-3 ulp.  */
+  const double
+    D0 = -3.33333333333333314830e-01,
+    D1 = -2.45614035087719298489e-02,
+    D2 = -4.42282176028306085735e-04,
+    D3 = -2.18410951125089397866e-06,
+    D4 = -1.52734930856705882380e-09,
+    P1 =  4.73684210526315763179e-01,
+    P2 =  2.88957688338493286218e-02,
+    P3 =  4.81596147230822140082e-04,
+    P4 =  2.26811372322208256697e-06,
+    P5 =  1.52734930856705882380e-09;
+  v_f64 a, z, e, p, q, t;
+  v_s64 m;
+
+  /* tanh(x) rounds to 1 from |x| = 22 on.  */
+  a = v_abs (x);
+  a = v_fill ((v_s64) (a > 22.0), a, 22.0);
+  m = (v_s64) (a < 0.75);
+
+  /* One division for both: q = z*D(z)/P(z) or 2/(exp(2|x|)+1).  */
+  z = a * a;
+  p = 1.0 + z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * P5))));
+  e = v_exp (2.0 * a) + 1.0;
+  q = v_sel (m, z * (D0 + z * (D1 + z * (D2 + z * (D3 + z * D4)))),
+	     v_dup (2.0)) / v_sel (m, p, e);
+  t = v_sel (m, a + a * q, 1.0 - q);
+  return (v_f64) ((v_s64) t | ((v_s64) x & V_SIGN));
+}
+
+/* pow(X, Y) for positive normal finite X and |Y| <= 2**31, within
+   1 ulp; see e_pow.c.  Lanes where the result may not be normal are
+   set in *SPECIAL.  */
+static inline v_f64
+v_pow (v_f64 x, v_f64 y, v_s64 *special)
+{
+  const double
+    dp_h1 = 5.84962487220764160156e-01, /* 0x3FE2B803, 0x40000000 */
+    dp_l1 = 1.35003920212974897128e-08, /* 0x3E4CFDEB, 0x43CFD006 */
+    L1 = 5.99999999999994648725e-01, /* 0x3FE33333, 0x33333303 */
+    L2 = 4.28571428578550184252e-01, /* 0x3FDB6DB6, 0xDB6FABFF */
+    L3 = 3.33333329818377432918e-01, /* 0x3FD55555, 0x518F264D */
+    L4 = 2.72728123808534006489e-01, /* 0x3FD17460, 0xA91D4101 */
+    L5 = 2.30660745775561754067e-01, /* 0x3FCD864A, 0x93C9DB65 */
+    L6 = 2.06975017800338417784e-01, /* 0x3FCA7E28, 0x4A454EEF */
+    P1 =  1.66666666666666019037e-01, /* 0x3FC55555, 0x5555553E */
+    P2 = -2.77777777770155933842e-03, /* 0xBF66C16C, 0x16BEBD93 */
+    P3 =  6.61375632143793436117e-05, /* 0x3F11566A, 0xAF25DE2C */
+    P4 = -1.65339022054652515390e-06, /* 0xBEBBBD41, 0xC5D26BF1 */
+    P5 =  4.13813679705723846039e-08, /* 0x3E663769, 0x72BEA4D0 */
+    lg2   =  6.93147180559945286227e-01, /* 0x3FE62E42, 0xFEFA39EF */
+    lg2_h =  6.93147182464599609375e-01, /* 0x3FE62E43, 0x00000000 */
+    lg2_l = -1.90465429995776804525e-09, /* 0xBE205C61, 0x0CA86C39 */
+    cp    =  9.61796693925975554329e-01, /* 0x3FEEC709, 0xDC3A03FD */
+    cp_h  =  9.61796700954437255859e-01, /* 0x3FEEC709, 0xE0000000 */
+    cp_l  = -7.02846165095275826516e-09; /* 0xBE3E2FE0, 0x145B01F5 */
+  v_f64 ax, bp, dp_h, dp_l, u, v, s, s_h, s_l, t_h, t_l, s2, r, p_h, p_l;
+  v_f64 z_h, z_l, t, t1, t2, y1, z, w;
+  v_u64 ix;
+  v_s64 j, n, k1, k2, ki;
+
+  /* log2(x) = n + dp_h + z_h + z_l = t1 + t2, as in e_pow.c with k
+     chosen lane by lane.  */
+  ix = (v_u64) x >> 32;
+  n = (v_s64) (ix >> 20) - 0x3ff;
+  j = (v_s64) ix & 0x000fffff;
+  t = v_cvt (j);
+  k2 = (v_s64) (t >= 0xBB67A);
+  k1 = (v_s64) (t > 0x3988E) ^ k2;
+  n -= k2;
+  ix = (v_u64) ((j | 0x3ff00000) + (k2 & -0x00100000));
+  ax = (v_f64) (((v_u64) x & ~V_HIGH) | (ix << 32));
+  bp = v_fill (k1, v_dup (1.0), 1.5);
+  dp_h = v_fill (k1, v_dup (0.0), dp_h1);
+  dp_l = v_fill (k1, v_dup (0.0), dp_l1);
+
+  u = ax - bp;
+  v = 1.0 / (ax + bp);
+  s = u * v;
+  s_h = v_trunc32 (s);
+  t_h = (v_f64) ((((ix >> 1) | 0x20000000) + 0x00080000
+		  + (v_u64) (k1 & (1 << 18))) << 32);
+  t_l = ax - (t_h - bp);
+  s_l = v * ((u - s_h * t_h) - s_h * t_l);
+  s2 = s * s;
+  r = s2 * s2 * (L1 + s2 * (L2 + s2 * (L3 + s2 * (L4 + s2 * (L5
+							       + s2 * L6)))));
+  r += s_l * (s_h + s);
+  s2 = s_h * s_h;
+  t_h = v_trunc32 (3.0 + s2 + r);
+  t_l = r - ((t_h - 3.0) - s2);
+  u = s_h * t_h;
+  v = s_l * t_h + t_l * s;
+  p_h = v_trunc32 (u + v);
+  p_l = v - (p_h - u);
+  z_h = cp_h * p_h;
+  z_l = cp_l * p_h + p_l * cp + dp_l;
+  t = v_cvt (n);
+  t1 = v_trunc32 (((z_h + z_l) + dp_h) + t);
+  t2 = z_l - (((t1 - t) - dp_h) - z_h);
+
+  /* y*log2(x) = p_h + p_l = n + (p_h - n) + p_l, |p_h - n + p_l| <= 1/2.  */
+  y1 = v_trunc32 (y);
+  p_l = (y - y1) * t1 + y * t2;
+  p_h = y1 * t1;
+  z = p_l + p_h;
+  *special = ~(v_s64) (v_abs (z) < 1020.0);
+  z = v_fill (*special, z, 0.0);
+  p_h = v_fill (*special, p_h, 0.0);
+  p_l = v_fill (*special, p_l, 0.0);
+  t = z + V_SHIFT;
+  ki = (v_s64) t - V_SHIFT_BITS;
+  p_h -= t - V_SHIFT;
+
+  /* 2**(p_h + p_l) */
+  t = v_trunc32 (p_l + p_h);
+  u = t * lg2_h;
+  v = (p_l - (t - p_h)) * lg2 + t * lg2_l;
+  z = u + v;
+  w = v - (z - u);
+  t = z * z;
+  t1 = z - t * (P1 + t * (P2 + t * (P3 + t * (P4 + t * P5))));
+  r = (z * t1) / (t1 - 2.0) - (w + z * w);
+  z = 1.0 - (r - z);
+  return (v_f64) ((v_s64) z + (ki << 52));
+}
+
+#endif /* V_LEN */
@@ -65,6 +65,7 @@ QUICKREF
 */
 
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -72,10 +73,11 @@ double complex
 ccosh(double complex z)
 {
 	double complex w;
-	double x, y;
+	double x, y, s, c;
 
 	x = creal(z);
 	y = cimag(z);
-	w = cosh(x) * cos(y) + (sinh(x) * sin(y)) * I;
+	sincos(y, &s, &c);
+	w = cosh(x) * c + (sinh(x) * s) * I;
 	return w;
 }
@@ -32,6 +32,7 @@
  * Marco Atzeri <marco_atzeri@yahoo.it>
  */
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -39,10 +40,11 @@ float complex
 ccoshf(float complex z)
 {
 	float complex w;
-	float x, y;
+	float x, y, s, c;
 
 	x = crealf(z);
 	y = cimagf(z);
-	w = coshf(x) * cosf(y) + (sinhf(x) * sinf(y)) * I;
+	sincosf(y, &s, &c);
+	w = coshf(x) * c + (sinhf(x) * s) * I;
 	return w;
 }
@@ -65,6 +65,7 @@ QUICKREF
 */
 
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -72,11 +73,12 @@ double complex
 cexp(double complex z)
 {
 	double complex w;
-	double r, x, y;
+	double r, x, y, s, c;
 
 	x = creal(z);
 	y = cimag(z);
 	r = exp(x);
-	w = r * cos(y) + r * sin(y) * I;
+	sincos(y, &s, &c);
+	w = r * c + r * s * I;
 	return w;
 }
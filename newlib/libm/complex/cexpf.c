@@ -32,6 +32,7 @@
  * Marco Atzeri <marco_atzeri@yahoo.it>
  */
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -39,11 +40,12 @@ float complex
 cexpf(float complex z)
 {
 	float complex w;
-	float r, x, y;
+	float r, x, y, s, c;
 
 	x = crealf(z);
 	y = cimagf(z);
 	r = expf(x);
-	w = r * cosf(y) + r * sinf(y) * I;
+	sincosf(y, &s, &c);
+	w = r * c + r * s * I;
 	return w;
 }
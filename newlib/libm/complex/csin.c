@@ -65,6 +65,7 @@ QUICKREF
 */
 
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 #include "cephes_subr.h"
@@ -73,9 +74,10 @@ double complex
 csin(double complex z)
 {
 	double complex w;
-	double ch, sh;
+	double ch, sh, s, c;
 
 	_cchsh(cimag(z), &ch, &sh);
-	w = sin(creal(z)) * ch + (cos(creal(z)) * sh) * I;
+	sincos(creal(z), &s, &c);
+	w = s * ch + (c * sh) * I;
 	return w;
 }
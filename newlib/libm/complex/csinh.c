@@ -64,6 +64,7 @@ QUICKREF
 
 */
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -71,10 +72,11 @@ double complex
 csinh(double complex z)
 {
 	double complex w;
-	double x, y;
+	double x, y, s, c;
 
 	x = creal(z);
 	y = cimag(z);
-	w = sinh(x) * cos(y) + (cosh(x) * sin(y)) * I;
+	sincos(y, &s, &c);
+	w = sinh(x) * c + (cosh(x) * s) * I;
 	return w;
 }
@@ -65,6 +65,7 @@ QUICKREF
 */
 
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 #include "cephes_subr.h"
@@ -73,9 +74,10 @@ double complex
 ctan(double complex z)
 {
 	double complex w;
-	double d;
+	double d, s, c;
 
-	d = cos(2.0 * creal(z)) + cosh(2.0 * cimag(z));
+	sincos(2.0 * creal(z), &s, &c);
+	d = c + cosh(2.0 * cimag(z));
 
 	if (fabs(d) < 0.25)
 		d = _ctans(z);
@@ -86,6 +88,6 @@ ctan(double complex z)
 		return w;
 	}
 
-	w = sin(2.0 * creal(z)) / d + (sinh(2.0 * cimag(z)) / d) * I;
+	w = s / d + (sinh(2.0 * cimag(z)) / d) * I;
 	return w;
 }
@@ -32,6 +32,7 @@
  * Marco Atzeri <marco_atzeri@yahoo.it>
  */
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 #include "cephes_subrf.h"
@@ -40,9 +41,10 @@ float complex
 ctanf(float complex z)
 {
 	float complex w;
-	float d;
+	float d, s, c;
 
-	d = cosf(2.0f * crealf(z)) + coshf(2.0f * cimagf(z));
+	sincosf(2.0f * crealf(z), &s, &c);
+	d = c + coshf(2.0f * cimagf(z));
 
 	if (fabsf(d) < 0.25f)
 		d = _ctansf(z);
@@ -53,6 +55,6 @@ ctanf(float complex z)
 		return w;
 	}
 
-	w = sinf(2.0f * crealf(z)) / d + (sinhf(2.0f * cimagf(z)) / d) * I;
+	w = s / d + (sinhf(2.0f * cimagf(z)) / d) * I;
 	return w;
 }
@@ -65,6 +65,7 @@ QUICKREF
 */
 
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -72,12 +73,13 @@ double complex
 ctanh(double complex z)
 {
 	double complex w;
-	double x, y, d;
+	double x, y, d, s, c;
 
 	x = creal(z);
 	y = cimag(z);
-	d = cosh(2.0 * x) + cos(2.0 * y);
-	w = sinh(2.0 * x) / d  +  (sin(2.0 * y) / d) * I;
+	sincos(2.0 * y, &s, &c);
+	d = cosh(2.0 * x) + c;
+	w = sinh(2.0 * x) / d  +  (s / d) * I;
 
 	return w;
 }
@@ -32,6 +32,7 @@
  * Marco Atzeri <marco_atzeri@yahoo.it>
  */
 
+#define _GNU_SOURCE
 #include <complex.h>
 #include <math.h>
 
@@ -39,12 +40,13 @@ float complex
 ctanhf(float complex z)
 {
 	float complex w;
-	float x, y, d;
+	float x, y, d, s, c;
 
 	x = crealf(z);
 	y = cimagf(z);
-	d = coshf(2.0f * x) + cosf(2.0f * y);
-	w = sinhf(2.0f * x) / d  +  (sinf(2.0f * y) / d) * I;
+	sincosf(2.0f * y, &s, &c);
+	d = coshf(2.0f * x) + c;
+	w = sinhf(2.0f * x) / d  +  (s / d) * I;
 
 	return w;
 }
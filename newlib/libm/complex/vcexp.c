@@ -0,0 +1,48 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include <complex.h>
+#include "../common/fdlibm.h"
+#include "../common/v_math.h"
+
+void
+vcexp(double complex *out, const double complex *in, size_t n)
+{
+#ifdef V_LEN
+	double_complex w;
+	v_f64 x, y, e, s, c;
+	v_s64 special;
+	int i;
+
+	for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN) {
+		/* A double complex is laid out as two doubles.  */
+		for (i = 0; i < V_LEN; i++) {
+			x[i] = ((const double *) in)[2 * i];
+			y[i] = ((const double *) in)[2 * i + 1];
+		}
+		/* x + y is a NaN if either is.  */
+		special = (v_s64) (v_abs(x) > 708.0)
+		    | (v_s64) (v_abs(y) > 1.6e6) | (v_s64) (x + y != x + y);
+		special |= v_sincos(v_fill(special, y, 0.0), &s, &c);
+		e = v_exp(v_fill(special, x, 0.0));
+		c *= e;
+		s *= e;
+		for (i = 0; i < V_LEN; i++) {
+			((double *) out)[2 * i] = c[i];
+			((double *) out)[2 * i + 1] = s[i];
+		}
+		if (v_any(special))
+			for (i = 0; i < V_LEN; i++)
+				if (special[i]) {
+					REAL_PART(w) = x[i];
+					IMAG_PART(w) = y[i];
+					out[i] = cexp(w.z);
+				}
+	}
+#endif
+	while (n-- > 0)
+		*out++ = cexp(*in++);
+}
@@ -0,0 +1,48 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+#define _ARRAY_MATH_SOURCE
+#include <complex.h>
+#include "../common/fdlibm.h"
+#include "../common/v_math.h"
+
+void
+vcexpf(float complex *out, const float complex *in, size_t n)
+{
+#ifdef V_LEN
+	float_complex w;
+	v_f64 x, y, e, s, c;
+	v_s64 special;
+	int i;
+
+	for (; n >= V_LEN; n -= V_LEN, in += V_LEN, out += V_LEN) {
+		/* A float complex is laid out as two floats.  */
+		for (i = 0; i < V_LEN; i++) {
+			x[i] = ((const float *) in)[2 * i];
+			y[i] = ((const float *) in)[2 * i + 1];
+		}
+		/* -87 to 88, as for vexpf; x + y is a NaN if either is.  */
+		special = (v_s64) (v_abs(x - 0.5) > 87.5)
+		    | (v_s64) (v_abs(y) > 1.6e6) | (v_s64) (x + y != x + y);
+		special |= v_sincos(v_fill(special, y, 0.0), &s, &c);
+		e = v_exp(v_fill(special, x, 0.0));
+		c *= e;
+		s *= e;
+		for (i = 0; i < V_LEN; i++) {
+			((float *) out)[2 * i] = (float) c[i];
+			((float *) out)[2 * i + 1] = (float) s[i];
+		}
+		if (v_any(special))
+			for (i = 0; i < V_LEN; i++)
+				if (special[i]) {
+					REAL_PART(w) = (float) x[i];
+					IMAG_PART(w) = (float) y[i];
+					out[i] = cexpf(w.z);
+				}
+	}
+#endif
+	while (n-- > 0)
+		*out++ = cexpf(*in++);
+}
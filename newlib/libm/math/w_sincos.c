@@ -1,5 +1,5 @@
-/* sincos -- currently no more efficient than two separate calls to
-   sin and cos. */
+/* sincos -- sine and cosine of the same argument, with one argument
+   reduction for both. */
 
 #include "fdlibm.h"
 #include <errno.h>
@@ -15,8 +15,36 @@
         double *cosx;
 #endif
 {
-  *sinx = sin (x);
-  *cosx = cos (x);
+	double y[2],s,c;
+	__int32_t n,ix;
+
+    /* High word of x. */
+	GET_HIGH_WORD(ix,x);
+
+    /* |x| ~< pi/4 */
+	ix &= 0x7fffffff;
+	if(ix <= 0x3fe921fb) {
+	    *sinx = __kernel_sin(x,0.0,0);
+	    *cosx = __kernel_cos(x,0.0);
+	    return;
+	}
+
+    /* sin(Inf or NaN) and cos(Inf or NaN) are NaN */
+	if (ix>=0x7ff00000) {
+	    *sinx = *cosx = x-x;
+	    return;
+	}
+
+    /* argument reduction needed; see s_sin.c for the table */
+	n = __ieee754_rem_pio2(x,y);
+	s = __kernel_sin(y[0],y[1],1);
+	c = __kernel_cos(y[0],y[1]);
+	switch(n&3) {
+	    case 0:  *sinx =  s; *cosx =  c; break;
+	    case 1:  *sinx =  c; *cosx = -s; break;
+	    case 2:  *sinx = -s; *cosx = -c; break;
+	    default: *sinx = -c; *cosx =  s; break;
+	}
 }
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
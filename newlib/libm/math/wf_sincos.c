@@ -1,5 +1,6 @@
-/* sincos -- currently no more efficient than two separate calls to
-   sin and cos. */
+/* sincosf -- sine and cosine of the same argument, with one argument
+   reduction for both. */
+
 #include "fdlibm.h"
 #include <errno.h>
 
@@ -12,8 +13,35 @@
         float *cosx;
 #endif
 {
-  *sinx = sinf (x);
-  *cosx = cosf (x);
+	float y[2],s,c;
+	__int32_t n,ix;
+
+	GET_FLOAT_WORD(ix,x);
+
+    /* |x| ~< pi/4 */
+	ix &= 0x7fffffff;
+	if(ix <= 0x3f490fd8) {
+	    *sinx = __kernel_sinf(x,0.0f,0);
+	    *cosx = __kernel_cosf(x,0.0f);
+	    return;
+	}
+
+    /* sinf(Inf or NaN) and cosf(Inf or NaN) are NaN */
+	if (!FLT_UWORD_IS_FINITE(ix)) {
+	    *sinx = *cosx = x-x;
+	    return;
+	}
+
+    /* argument reduction needed; see sf_sin.c */
+	n = __ieee754_rem_pio2f(x,y);
+	s = __kernel_sinf(y[0],y[1],1);
+	c = __kernel_cosf(y[0],y[1]);
+	switch(n&3) {
+	    case 0:  *sinx =  s; *cosx =  c; break;
+	    case 1:  *sinx =  c; *cosx = -s; break;
+	    case 2:  *sinx = -s; *cosx = -c; break;
+	    default: *sinx = -c; *cosx =  s; break;
+	}
 }
 
 #ifdef _DOUBLE_IS_32BITS
@@ -23,11 +51,14 @@
 #else
 	void sincos(x, sinx, cosx)
 	double x;
-        double sinx;
-        double cosx;
+        double *sinx;
+        double *cosx;
 #endif
 {
-  *sinx = sinf((float) x);
-  *cosx = cosf((float) x);
+  float s, c;
+
+  sincosf((float) x, &s, &c);
+  *sinx = s;
+  *cosx = c;
 }
 #endif /* defined(_DOUBLE_IS_32BITS) */
@@ -0,0 +1,96 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Conversions between two 8-bit tables go through a byte map.  Check
+   them against the same conversion done in two steps through UTF-8,
+   for every byte value, including ones with no counterpart, and with
+   output buffers too small for the input.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iconv.h>
+#include <errno.h>
+#include <newlib.h>
+#include "check.h"
+
+#if defined(_ICONV_ENABLED) \
+ && defined(_ICONV_FROM_ENCODING_KOI8_R) \
+ && defined(_ICONV_TO_ENCODING_WIN_1251) \
+ && defined(_ICONV_FROM_ENCODING_UTF_8) \
+ && defined(_ICONV_TO_ENCODING_UTF_8)
+
+#define LEN 1024
+
+static char in[LEN];
+static char out[LEN];
+static char want[LEN];
+static char utf8[LEN * 4];
+
+int main(int argc, char **argv)
+{
+    iconv_t cd, to_utf8, from_utf8;
+    char *inbuf, *outbuf;
+    size_t inbytes, outbytes, n, want_n, want_len;
+    int i;
+
+    for (i = 0; i < LEN; i++)
+        in[i] = (char)(i * 7 + i / 256);
+
+    CHECK((cd = iconv_open("WIN-1251", "KOI8-R")) != (iconv_t)-1);
+    CHECK((to_utf8 = iconv_open("UTF-8", "KOI8-R")) != (iconv_t)-1);
+    CHECK((from_utf8 = iconv_open("WIN-1251", "UTF-8")) != (iconv_t)-1);
+
+    inbuf = in;
+    inbytes = LEN;
+    outbuf = utf8;
+    outbytes = sizeof(utf8);
+    CHECK(iconv(to_utf8, &inbuf, &inbytes, &outbuf, &outbytes) == 0);
+    inbytes = outbuf - utf8;
+    inbuf = utf8;
+    outbuf = want;
+    outbytes = LEN;
+    want_n = iconv(from_utf8, &inbuf, &inbytes, &outbuf, &outbytes);
+    CHECK(want_n != (size_t)-1 && want_n > 0);
+    want_len = outbuf - want;
+    CHECK(want_len == LEN);
+
+    inbuf = in;
+    inbytes = LEN;
+    outbuf = out;
+    outbytes = LEN;
+    n = iconv(cd, &inbuf, &inbytes, &outbuf, &outbytes);
+    CHECK(n == want_n);
+    CHECK(inbytes == 0 && outbytes == 0);
+    CHECK(memcmp(out, want, LEN) == 0);
+
+    /* Output buffer ends in the middle of the input.  */
+    for (i = 0; i < 9; i++)
+    {
+        inbuf = in + i;
+        inbytes = LEN - i;
+        outbuf = out;
+        outbytes = 100 + i;
+        errno = 0;
+        CHECK(iconv(cd, &inbuf, &inbytes, &outbuf, &outbytes) == (size_t)-1);
+        CHECK(errno == E2BIG);
+        CHECK(inbuf == in + 100 + 2 * i && outbytes == 0);
+        CHECK(memcmp(out, want + i, 100 + i) == 0);
+    }
+
+    CHECK(iconv_close(cd) != -1);
+    CHECK(iconv_close(to_utf8) != -1);
+    CHECK(iconv_close(from_utf8) != -1);
+
+    exit(0);
+}
+
+#else
+int main(int argc, char **argv)
+{
+    puts("KOI8-R, WIN-1251 or UTF-8 converter not linked, SKIP test");
+    exit(0);
+}
+#endif
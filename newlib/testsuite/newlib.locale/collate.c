@@ -0,0 +1,161 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Outside the "C" locale, strcoll and wcscoll order by base letter, then
+   accent, then case, and strxfrm and wcsxfrm keys compare the same way
+   with strcmp and wcscmp.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <newlib.h>
+#include "check.h"
+
+#if defined(_MB_CAPABLE)
+
+/* In increasing order.  */
+static const char *words[] = {
+  " x",
+  "-x",
+  "1",
+  "9",
+  "a",
+  "A",
+  "\xc3\xa1",			/* a acute */
+  "\xc3\x81",			/* A acute */
+  "\xc3\xa4",			/* a diaeresis */
+  "azur",
+  "\xc3\x86" "ble",		/* AE */
+  "b",
+  "resume",
+  "Resume",
+  "r\xc3\xa9sum\xc3\xa9",	/* e acute */
+  "R\xc3\xa9sum\xc3\xa9",
+  "strasse",
+  "stra\xc3\x9f" "e",		/* sharp s */
+  "strasser",
+  "zebra",
+  "\xce\xb1\xce\xb2",		/* alpha beta */
+  "\xce\x91\xce\xb2",		/* Alpha beta */
+  "\xce\xac\xce\xb2",		/* alpha tonos beta */
+  "\xd0\xb3",			/* ghe */
+  "\xd2\x91",			/* ghe with upturn */
+  "\xd0\xb4",			/* de */
+  "\xd0\xb5",			/* ie */
+  "\xd1\x91",			/* io */
+  "\xd0\xb6",			/* zhe */
+  "\xd1\x8f",			/* ya */
+  "\xe4\xb8\xad",		/* CJK */
+};
+
+#define NWORDS (sizeof (words) / sizeof (words[0]))
+#define NSORT 1000
+
+static char keys[NWORDS][64];
+static wchar_t wwords[NWORDS][16];
+static wchar_t wkeys[NWORDS][64];
+static char sorted[NSORT][32];
+static char sortkeys[NSORT][192];
+static int byname[NSORT], bykey[NSORT];
+
+static int
+sign (int r)
+{
+  return (r > 0) - (r < 0);
+}
+
+static int
+compare_coll (const void *a, const void *b)
+{
+  return strcoll (sorted[*(const int *) a], sorted[*(const int *) b]);
+}
+
+static int
+compare_key (const void *a, const void *b)
+{
+  return strcmp (sortkeys[*(const int *) a], sortkeys[*(const int *) b]);
+}
+
+int main(int argc, char **argv)
+{
+  size_t i, j, n;
+  unsigned int seed = 1;
+  char buf[8];
+
+  if (setlocale (LC_ALL, "en_US.UTF-8") == NULL)
+    {
+      puts ("en_US.UTF-8 locale not supported, SKIP test");
+      exit (0);
+    }
+
+  for (i = 0; i < NWORDS; i++)
+    {
+      n = strxfrm (keys[i], words[i], sizeof (keys[i]));
+      CHECK (n < sizeof (keys[i]) && strlen (keys[i]) == n);
+      CHECK (strxfrm (NULL, words[i], 0) == n);
+      CHECK (strxfrm (buf, words[i], 2) == n);
+      CHECK (mbstowcs (wwords[i], words[i], 16) != (size_t) -1);
+      n = wcsxfrm (wkeys[i], wwords[i], 64);
+      CHECK (n < 64 && wcslen (wkeys[i]) == n);
+    }
+  for (i = 0; i < NWORDS; i++)
+    for (j = 0; j < NWORDS; j++)
+      {
+	int want = i < j ? -1 : i > j;
+
+	CHECK (sign (strcoll (words[i], words[j])) == want);
+	CHECK (sign (strcmp (keys[i], keys[j])) == want);
+	CHECK (sign (wcscoll (wwords[i], wwords[j])) == want);
+	CHECK (sign (wcscmp (wkeys[i], wkeys[j])) == want);
+      }
+
+  /* A combining accent weighs the same as a precomposed one.  */
+  CHECK (strcoll ("\xc3\xa9y", "e\xcc\x81x") > 0);
+  CHECK (strcoll ("\xc3\xa9x", "e\xcc\x81y") < 0);
+
+  /* Control characters are ignored up to the final tie-break.  */
+  CHECK (strcoll ("ab\001", "ab") > 0);
+  CHECK (strcoll ("a\001c", "ab") > 0);
+  CHECK (strcoll ("a\001a", "ab") < 0);
+
+  /* Sorting with strcoll and with the keys gives the same order.  */
+  for (i = 0; i < NSORT; i++)
+    {
+      n = 0;
+      for (j = 0; j < 4; j++)
+	{
+	  seed = seed * 1103515245 + 12345;
+	  strcpy (sorted[i] + n, words[(seed >> 16) % NWORDS]);
+	  n += strlen (sorted[i] + n);
+	  if (n > 16)
+	    break;
+	}
+      CHECK (strxfrm (sortkeys[i], sorted[i], 192) < 192);
+      byname[i] = bykey[i] = i;
+    }
+  qsort (byname, NSORT, sizeof (int), compare_coll);
+  qsort (bykey, NSORT, sizeof (int), compare_key);
+  for (i = 0; i < NSORT; i++)
+    CHECK (strcmp (sorted[byname[i]], sorted[bykey[i]]) == 0);
+  for (i = 1; i < NSORT; i++)
+    CHECK (strcoll (sorted[byname[i - 1]], sorted[byname[i]]) <= 0);
+
+  /* The "C" locale still compares bytes.  */
+  setlocale (LC_COLLATE, "C");
+  CHECK (strcoll ("a", "B") > 0);
+  CHECK (strxfrm (buf, "abc", sizeof (buf)) == 3 && strcmp (buf, "abc") == 0);
+
+  exit (0);
+}
+
+#else
+int main(int argc, char **argv)
+{
+  puts ("No multibyte support, SKIP test");
+  exit (0);
+}
+#endif
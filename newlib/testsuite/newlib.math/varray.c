@@ -0,0 +1,222 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* The array functions agree with the scalar functions they apply to
+   within a couple of ulp, and exactly for the zeros, infinities, NaNs
+   and out-of-range arguments they hand to the scalar function; errno
+   is set the same way.  An empty array is left alone, and the output
+   may be the input array.  */
+
+#define _GNU_SOURCE
+#define _ARRAY_MATH_SOURCE
+#include <math.h>
+#include <complex.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#define N 1000
+
+static double din[N], din2[N], dout[N], dref[N];
+static float fin[N], fin2[N], fout[N], fref[N];
+static double dout2[N], dref2[N];
+static float fout2[N], fref2[N];
+static double complex zin[N], zout[N], zref[N];
+static float complex fzin[N], fzout[N], fzref[N];
+
+/* A and B are the same, or both finite, nonzero and at most TOL
+   units in the last place apart.  */
+static int
+dnear (double a, double b, int tol)
+{
+  __int64_t i, j;
+
+  if (memcmp (&a, &b, sizeof a) == 0)
+    return 1;
+  if (!isfinite (a) || !isfinite (b) || a == 0 || b == 0
+      || signbit (a) != signbit (b))
+    return 0;
+  memcpy (&i, &a, sizeof i);
+  memcpy (&j, &b, sizeof j);
+  return i - j <= tol && j - i <= tol;
+}
+
+static int
+fnear (float a, float b, int tol)
+{
+  __int32_t i, j;
+
+  if (memcmp (&a, &b, sizeof a) == 0)
+    return 1;
+  if (!isfinite (a) || !isfinite (b) || a == 0 || b == 0
+      || signbit (a) != signbit (b))
+    return 0;
+  memcpy (&i, &a, sizeof i);
+  memcpy (&j, &b, sizeof j);
+  return i - j <= tol && j - i <= tol;
+}
+
+#define NEAR(a, b, tol)							\
+  (sizeof (a) == sizeof (float) ? fnear (a, b, tol) : dnear (a, b, tol))
+
+static unsigned long seed = 1;
+
+/* A pseudo-random number in [-SCALE, SCALE).  */
+static double
+lcg (double scale)
+{
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return (seed / 1073741824.0 - 1.0) * scale;
+}
+
+/* Check VF against F, to within TOL ulp, on IN (and IN2 for
+   two-argument functions), separately, in place, and with no elements
+   at all.  */
+#define TEST(T, VF, F, TOL, IN, OUT, REF, ARGS, VARGS)			\
+  do									\
+    {									\
+      int i, e;								\
+									\
+      for (i = 0; i < N; i++)						\
+	{								\
+	  errno = 0;							\
+	  REF[i] = F ARGS;						\
+	}								\
+      e = errno;							\
+									\
+      memset (OUT, 0x5a, sizeof OUT);					\
+      errno = 0;							\
+      VF VARGS (OUT, N);						\
+      for (i = 0; i < N; i++)						\
+	CHECK (NEAR (OUT[i], REF[i], TOL));					\
+      /* Only the last element's errno is known: earlier ones may	\
+	 be overwritten, or not, as with a loop of scalar calls.  */	\
+      if (e != 0)							\
+	CHECK (errno == e);						\
+									\
+      memset (OUT, 0x5a, sizeof OUT);					\
+      VF VARGS (OUT, 0);						\
+      for (i = 0; i < N; i++)						\
+	CHECK (memcmp (&OUT[i], "\x5a\x5a\x5a\x5a\x5a\x5a\x5a\x5a",	\
+		       sizeof (T)) == 0);				\
+									\
+      memcpy (OUT, IN, sizeof OUT);					\
+      VF INPLACE_##VARGS (OUT, N);					\
+      for (i = 0; i < N; i++)						\
+	CHECK (NEAR (OUT[i], REF[i], TOL));					\
+    }									\
+  while (0)
+
+#define ARGS1(out, n)		(out, din, n)
+#define INPLACE_ARGS1(out, n)	(out, out, n)
+#define ARGS2(out, n)		(out, din, din2, n)
+#define INPLACE_ARGS2(out, n)	(out, out, din2, n)
+#define FARGS1(out, n)		(out, fin, n)
+#define INPLACE_FARGS1(out, n)	(out, out, n)
+#define FARGS2(out, n)		(out, fin, fin2, n)
+#define INPLACE_FARGS2(out, n)	(out, out, fin2, n)
+
+int main()
+{
+  /* Mostly within the ranges of the vector kernels, with some
+     elements beyond them.  */
+  static const double scale[] = { 1.0, 30.0, 800.0, 2e6 };
+  static const double special[] = {
+    0.0, -0.0, 1.0, -1.0, 0.5, 2.0, 1e-300, -1e-300, 700.0, -750.0,
+    1e300, -1e300, 1e22, 3.0e9, -0.1
+  };
+  int i, n = sizeof special / sizeof special[0];
+
+  for (i = 0; i < N; i++)
+    {
+      din[i] = i < n ? special[i] : lcg (scale[i / 7 % 4]);
+      din2[i] = i < n ? special[n - 1 - i] : lcg (scale[i / 5 % 4]);
+      fin[i] = (float) din[i];
+      fin2[i] = (float) din2[i];
+    }
+  din[N - 1] = -2.0;		/* log, sqrt and pow set errno last */
+  din2[N - 1] = 0.5;
+  fin[N - 1] = -2.0f;
+  fin2[N - 1] = 0.5f;
+  din[N - 2] = INFINITY;
+  din[N - 3] = NAN;
+  fin[N - 2] = INFINITY;
+  fin[N - 3] = NAN;
+
+  /* The kernels are good to 1 ulp (tanh, 1.5), and so are most
+     scalar functions; powf loses up to a dozen ulp where y*log2(x)
+     is large, while vpowf works in double.  */
+  TEST (double, vexp, exp, 2, din, dout, dref, (din[i]), ARGS1);
+  TEST (double, vlog, log, 2, din, dout, dref, (din[i]), ARGS1);
+  TEST (double, vsin, sin, 2, din, dout, dref, (din[i]), ARGS1);
+  TEST (double, vcos, cos, 2, din, dout, dref, (din[i]), ARGS1);
+  TEST (double, vsqrt, sqrt, 0, din, dout, dref, (din[i]), ARGS1);
+  TEST (double, vtanh, tanh, 3, din, dout, dref, (din[i]), ARGS1);
+  TEST (double, vpow, pow, 2, din, dout, dref, (din[i], din2[i]), ARGS2);
+
+  TEST (float, vexpf, expf, 2, fin, fout, fref, (fin[i]), FARGS1);
+  TEST (float, vlogf, logf, 2, fin, fout, fref, (fin[i]), FARGS1);
+  TEST (float, vsinf, sinf, 2, fin, fout, fref, (fin[i]), FARGS1);
+  TEST (float, vcosf, cosf, 2, fin, fout, fref, (fin[i]), FARGS1);
+  TEST (float, vsqrtf, sqrtf, 0, fin, fout, fref, (fin[i]), FARGS1);
+  TEST (float, vtanhf, tanhf, 3, fin, fout, fref, (fin[i]), FARGS1);
+  TEST (float, vpowf, powf, 16, fin, fout, fref, (fin[i], fin2[i]), FARGS2);
+
+  /* sincos gives two results per element.  */
+  for (i = 0; i < N; i++)
+    {
+      sincos (din[i], &dref[i], &dref2[i]);
+      sincosf (fin[i], &fref[i], &fref2[i]);
+    }
+  vsincos (dout, dout2, din, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (dout[i], dref[i], 2) && NEAR (dout2[i], dref2[i], 2));
+  vsincosf (fout, fout2, fin, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (fout[i], fref[i], 2) && NEAR (fout2[i], fref2[i], 2));
+  memset (dout, 0x5a, sizeof dout);
+  vsincos (dout, dout2, din, 0);
+  vsincosf ((float *) dout, fout2, fin, 0);
+  for (i = 1; i < N; i++)
+    CHECK (memcmp (&dout[i], &dout[0], sizeof dout[0]) == 0);
+  memcpy (dout, din, sizeof dout);
+  vsincos (dout, dout2, dout, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (dout[i], dref[i], 2) && NEAR (dout2[i], dref2[i], 2));
+
+  /* cexp, on the real and imaginary parts above.  Each part is a
+     product of two rounded results, and cexpf rounds in float.  */
+  for (i = 0; i < N; i++)
+    {
+      zin[i] = din2[i] * 0.5 + din[i] * I;
+      fzin[i] = fin2[i] * 0.5f + fin[i] * I;
+      zref[i] = cexp (zin[i]);
+      fzref[i] = cexpf (fzin[i]);
+    }
+  vcexp (zout, zin, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (creal (zout[i]), creal (zref[i]), 3)
+	   && NEAR (cimag (zout[i]), cimag (zref[i]), 3));
+  vcexpf (fzout, fzin, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (crealf (fzout[i]), crealf (fzref[i]), 4)
+	   && NEAR (cimagf (fzout[i]), cimagf (fzref[i]), 4));
+  memset (zout, 0x5a, sizeof zout);
+  vcexp (zout, zin, 0);
+  vcexpf ((float complex *) zout, fzin, 0);
+  for (i = 1; i < N; i++)
+    CHECK (memcmp (&zout[i], &zout[0], sizeof zout[0]) == 0);
+  vcexp (zin, zin, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (creal (zin[i]), creal (zref[i]), 3)
+	   && NEAR (cimag (zin[i]), cimag (zref[i]), 3));
+  vcexpf (fzin, fzin, N);
+  for (i = 0; i < N; i++)
+    CHECK (NEAR (crealf (fzin[i]), crealf (fzref[i]), 4)
+	   && NEAR (cimagf (fzin[i]), cimagf (fzref[i]), 4));
+
+  exit (0);
+}
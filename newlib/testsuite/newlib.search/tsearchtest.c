@@ -0,0 +1,153 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/*
+ * Test program for tsearch() et al.  Sorted insertions must keep the
+ * tree shallow, and twalk() must see the keys in order after any mix
+ * of insertions and deletions.
+ */
+
+#include <search.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define	TEST(e)	((e) ? (void)0 : testfail(__FILE__, __LINE__, #e))
+
+#define	NKEYS	4096
+
+static int keys[NKEYS];
+static int present[NKEYS];
+static int walk_last, walk_count, walk_depth;
+static int destroyed;
+
+static void
+testfail(const char *file, unsigned long line, const char *expression)
+{
+
+	fprintf(stderr, "TEST FAILED: %s: file %s, line %ld\n",
+	    expression, file, line);
+	exit(1);
+}
+
+static int
+compare(const void *a, const void *b)
+{
+
+	return *(const int *)a - *(const int *)b;
+}
+
+static void
+walk(const void *node, VISIT v, int level)
+{
+	int key = **(int *const *)node;
+
+	if (level > walk_depth)
+		walk_depth = level;
+	if (v == postorder || v == leaf) {
+		TEST(key > walk_last);
+		TEST(present[key]);
+		walk_last = key;
+		walk_count++;
+	}
+}
+
+static void
+check(void *root, int count)
+{
+
+	walk_last = -1;
+	walk_count = walk_depth = 0;
+	twalk(root, walk);
+	TEST(walk_count == count);
+	/* 2 * log2(NKEYS + 1) */
+	TEST(walk_depth < 2 * 13);
+}
+
+static void
+destroy(void *key)
+{
+
+	TEST(present[*(int *)key]);
+	present[*(int *)key] = 0;
+	destroyed++;
+}
+
+int
+main(void)
+{
+	void *root = NULL;
+	void *node;
+	unsigned int seed = 1;
+	int i, round, count = 0;
+
+	for (i = 0; i < NKEYS; i++)
+		keys[i] = i;
+
+	/* Sorted insertions. */
+	for (i = 0; i < NKEYS; i++) {
+		node = tsearch(&keys[i], &root, compare);
+		TEST(node != NULL && *(int **)node == &keys[i]);
+		present[i] = 1;
+		count++;
+	}
+	check(root, count);
+	for (i = 0; i < NKEYS; i++) {
+		node = tfind(&keys[i], &root, compare);
+		TEST(node != NULL && *(int **)node == &keys[i]);
+	}
+
+	/* Duplicates are found, not inserted. */
+	node = tsearch(&keys[17], &root, compare);
+	TEST(node != NULL && *(int **)node == &keys[17]);
+
+	/* Random deletions and reinsertions. */
+	for (i = 0; i < 8 * NKEYS; i++) {
+		int k;
+
+		seed = seed * 1103515245 + 12345;
+		k = (seed >> 8) % NKEYS;
+		if (present[k]) {
+			TEST(tdelete(&keys[k], &root, compare) != NULL);
+			TEST(tfind(&keys[k], &root, compare) == NULL);
+			present[k] = 0;
+			count--;
+		} else {
+			node = tsearch(&keys[k], &root, compare);
+			TEST(node != NULL && *(int **)node == &keys[k]);
+			present[k] = 1;
+			count++;
+		}
+		if (i % 1024 == 0)
+			check(root, count);
+	}
+	check(root, count);
+
+	/* Deleting something that's not there. */
+	for (i = 0; i < NKEYS && present[i]; i++)
+		;
+	if (i < NKEYS)
+		TEST(tdelete(&keys[i], &root, compare) == NULL);
+
+	tdestroy(root, destroy);
+	TEST(destroyed == count);
+
+	/* Emptied slabs are reused after tdestroy and after tdelete. */
+	for (round = 0; round < 3; round++) {
+		root = NULL;
+		for (i = 0; i < NKEYS; i++) {
+			node = tsearch(&keys[(i * 7) % NKEYS], &root, compare);
+			TEST(node != NULL && *(int **)node == &keys[(i * 7) % NKEYS]);
+			present[(i * 7) % NKEYS] = 1;
+		}
+		check(root, NKEYS);
+		for (i = 0; i < NKEYS; i++) {
+			TEST(tdelete(&keys[i], &root, compare) != NULL);
+			present[i] = 0;
+		}
+		TEST(root == NULL);
+	}
+
+	exit(0);
+}
@@ -0,0 +1,105 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* An adaptive stream (__fsetbuffering) grows its malloc'ed buffer on
+   sequential transfers and shrinks it again on a seek.  Line buffers
+   and buffers given to setvbuf keep their size, and switching modes in
+   the middle of a file must not lose or reorder data.  */
+
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#define NAME "adaptbuf.tmp"
+#define LEN 300000
+#define MAXBUF (64 * 1024)
+
+static char ubuf[1000];
+
+static int
+byte (int i, int x)
+{
+  return (unsigned char) ((i * 13 + i / 509) ^ x);
+}
+
+/* Read bytes FROM to TO with getc and check them against byte (i, X).  */
+static void
+check_getc (FILE *fp, int from, int to, int x)
+{
+  int i;
+
+  for (i = from; i < to; i++)
+    CHECK (getc (fp) == byte (i, x));
+}
+
+int main()
+{
+  FILE *fp;
+  char chunk[100];
+  int base, size, i, j;
+
+  CHECK ((fp = fopen (NAME, "w+")) != NULL);
+  CHECK (__fsetbuffering (fp, FSETBUFFERING_QUERY) == FSETBUFFERING_FIXED);
+  CHECK (__fsetbuffering (fp, FSETBUFFERING_ADAPTIVE)
+	 == FSETBUFFERING_FIXED);
+  CHECK (__fsetbuffering (fp, FSETBUFFERING_QUERY)
+	 == FSETBUFFERING_ADAPTIVE);
+
+  /* Byte-at-a-time writes grow the buffer, up to the limit.  */
+  CHECK (putc (byte (0, 0), fp) == byte (0, 0));
+  base = fp->_bf._size;
+  for (i = 1; i < LEN; i++)
+    CHECK (putc (byte (i, 0), fp) == byte (i, 0));
+  CHECK (fp->_bf._size > base && fp->_bf._size <= MAXBUF);
+
+  /* A seek puts it back to its first size; reads grow it again.  */
+  CHECK (fseek (fp, 0, SEEK_SET) == 0);
+  CHECK (fp->_bf._size == base);
+  check_getc (fp, 0, LEN / 3, 0);
+  CHECK (fp->_bf._size > base && fp->_bf._size <= MAXBUF);
+
+  /* A line buffer is never resized.  */
+  CHECK (setvbuf (fp, NULL, _IOLBF, 0) == 0);
+  size = fp->_bf._size;
+  for (i = LEN / 3; i < LEN / 2; i += sizeof chunk)
+    {
+      CHECK (fread (chunk, 1, sizeof chunk, fp) == sizeof chunk);
+      for (j = 0; j < sizeof chunk; j++)
+	CHECK ((unsigned char) chunk[j] == byte (i + j, 0));
+    }
+  CHECK (fp->_bf._size == size);
+
+  /* Nor is a buffer from the caller, reading or writing.  */
+  CHECK (setvbuf (fp, ubuf, _IOFBF, sizeof ubuf) == 0);
+  check_getc (fp, i, LEN, 0);
+  CHECK (getc (fp) == EOF);
+  CHECK (fp->_bf._base == (unsigned char *) ubuf
+	 && fp->_bf._size == sizeof ubuf);
+  CHECK (fseek (fp, 0, SEEK_SET) == 0);
+  for (i = 0; i < LEN / 2; i++)
+    CHECK (putc (byte (i, 0x55), fp) == byte (i, 0x55));
+  CHECK (fp->_bf._size == sizeof ubuf);
+
+  /* A buffer that setvbuf allocates adapts again.  */
+  CHECK (setvbuf (fp, NULL, _IOFBF, 0) == 0);
+  for (; i < LEN; i++)
+    CHECK (putc (byte (i, 0x55), fp) == byte (i, 0x55));
+  CHECK (fp->_bf._size > base && fp->_bf._size <= MAXBUF);
+
+  /* Back in fixed mode, the size stays put across seeks and reads.  */
+  CHECK (__fsetbuffering (fp, FSETBUFFERING_FIXED)
+	 == FSETBUFFERING_ADAPTIVE);
+  CHECK (fseek (fp, 0, SEEK_SET) == 0);
+  size = fp->_bf._size;
+  check_getc (fp, 0, LEN, 0x55);
+  CHECK (getc (fp) == EOF);
+  CHECK (fp->_bf._size == size);
+
+  CHECK (fclose (fp) == 0);
+  CHECK (remove (NAME) == 0);
+  exit (0);
+}
@@ -0,0 +1,79 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Large fwrite and fread calls bypass the stream buffer for whole
+   buffer-sized blocks.  A large write after a partial buffer must
+   still come out after the buffered bytes, and a large read after a
+   partial one must pick up where the buffer left off.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#define NAME "bigio.tmp"
+#define LEN 20000
+
+static char data[LEN];
+static char buf[LEN];
+
+/* Write DATA in chunks of the given sizes, then read it back with
+   reads of the given sizes.  BUFSZ of 0 keeps the default buffer.  */
+static void
+test (size_t bufsz, const size_t *wsz, const size_t *rsz)
+{
+  FILE *fp;
+  size_t pos, n;
+  int c;
+
+  CHECK ((fp = fopen (NAME, "w")) != NULL);
+  if (bufsz != 0)
+    CHECK (setvbuf (fp, NULL, _IOFBF, bufsz) == 0);
+  /* No ftell in between: it would flush the buffer.  */
+  for (pos = 0; *wsz != 0; pos += *wsz++)
+    CHECK (fwrite (data + pos, 1, *wsz, fp) == *wsz);
+  CHECK (fwrite (data + pos, 1, LEN - pos, fp) == LEN - pos);
+  CHECK (ftell (fp) == LEN);
+  CHECK (fclose (fp) == 0);
+
+  memset (buf, 0, sizeof buf);
+  CHECK ((fp = fopen (NAME, "r")) != NULL);
+  if (bufsz != 0)
+    CHECK (setvbuf (fp, NULL, _IOFBF, bufsz) == 0);
+  for (pos = 0; *rsz != 0; pos += *rsz++)
+    {
+      CHECK (fread (buf + pos, 1, *rsz, fp) == *rsz);
+      CHECK (ftell (fp) == (long) (pos + *rsz));
+    }
+  /* A pushed-back character comes first, even before a large read.  */
+  CHECK ((c = getc (fp)) == (unsigned char) data[pos]);
+  CHECK (ungetc (c, fp) == c);
+  n = fread (buf + pos, 1, LEN, fp);
+  CHECK (n == LEN - pos);
+  CHECK (fread (buf, 1, 1, fp) == 0 && feof (fp));
+  CHECK (fclose (fp) == 0);
+  CHECK (memcmp (buf, data, LEN) == 0);
+}
+
+int main()
+{
+  static const size_t w1[] = { 100, 5000, 10, 3000, 1, 0 };
+  static const size_t w2[] = { 511, 1, 513, 4096, 0 };
+  static const size_t r1[] = { 7, 6000, 3, 1024, 0 };
+  static const size_t r2[] = { 512, 2048, 1, 1023, 0 };
+  int i;
+
+  for (i = 0; i < LEN; i++)
+    data[i] = (char) (i * 7 + i / 251);
+
+  test (0, w1, r1);
+  test (512, w1, r1);
+  test (512, w2, r2);
+  test (1000, w2, r1);
+  test (1, w1, r2);
+
+  CHECK (remove (NAME) == 0);
+  exit (0);
+}
@@ -0,0 +1,63 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* __getdelim copies whole runs out of the stream buffer.  Check lines
+   shorter and longer than both the stream and the line buffer, a
+   missing final delimiter, and delimiters that are not bytes.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#define LEN 20000
+
+static char data[LEN];
+
+int main()
+{
+  FILE *fp;
+  char *line = NULL;
+  size_t n = 0;
+  ssize_t len;
+  int i, start;
+
+  for (i = 0; i < LEN; i++)
+    data[i] = 'a' + i % 26;
+  /* Lines of 1, 1, 2, 4, ... bytes, then a long one.  */
+  for (i = 0; i < 4000; i = 2 * i + 1)
+    data[i] = '\n';
+
+  CHECK ((fp = fmemopen (data, LEN, "r")) != NULL);
+  start = 0;
+  while ((len = __getline (&line, &n, fp)) != -1)
+    {
+      CHECK (len > 0 && n > len);
+      CHECK (memcmp (line, data + start, len) == 0);
+      CHECK (line[len] == '\0');
+      start += len;
+      CHECK (line[len - 1] == '\n' || start == LEN);
+    }
+  CHECK (start == LEN);
+  CHECK (feof (fp));
+  fclose (fp);
+
+  /* Delimiters outside unsigned char never match.  */
+  CHECK ((fp = fmemopen (data, LEN, "r")) != NULL);
+  CHECK (__getdelim (&line, &n, 'a' + 256, fp) == LEN);
+  CHECK (memcmp (line, data, LEN) == 0);
+  fclose (fp);
+
+  CHECK ((fp = fmemopen (data, LEN, "r")) != NULL);
+  CHECK (__getdelim (&line, &n, 'c', fp) == 3);
+  CHECK (strcmp (line, "\n\nc") == 0);
+  CHECK (getc (fp) == '\n');
+  CHECK (__getdelim (&line, &n, 'f', fp) == 2);
+  CHECK (strcmp (line, "ef") == 0);
+  fclose (fp);
+
+  free (line);
+  exit (0);
+}
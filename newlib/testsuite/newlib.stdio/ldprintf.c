@@ -0,0 +1,79 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Long double output must be exact and round to nearest, ties to even,
+   at any exponent, and must read back to the same value.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <newlib.h>
+#include "check.h"
+
+#if defined(_WANT_IO_LONG_DOUBLE) && LDBL_MANT_DIG == 64
+
+static char buf[256];
+
+static const char *
+fmt (const char *f, long double x)
+{
+  snprintf (buf, sizeof (buf), f, x);
+  return buf;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int seed = 1;
+  long double x, y;
+  int i;
+
+  CHECK (strcmp (fmt ("%.30Le", 0.1L),
+		 "1.000000000000000000013552527156e-01") == 0);
+  CHECK (strcmp (fmt ("%.25Le", 1e4000L),
+		 "9.9999999999999999999654639e+3999") == 0);
+  CHECK (strcmp (fmt ("%.20Le", 3.6451995318824746025e-4951L),
+		 "3.64519953188247460253e-4951") == 0);
+  CHECK (strcmp (fmt ("%.42Le", 0xf.f1c4dc2d0442c1p7589L),
+		 "5.238965638652598168997616807544996978256178e+2285") == 0);
+  CHECK (strcmp (fmt ("%.40Lf", 1.0L / 3),
+		 "0.3333333333333333333423683514373792036167") == 0);
+  CHECK (strcmp (fmt ("%Lf", 1e30L),
+		 "1000000000000000000024696061952.000000") == 0);
+  CHECK (strcmp (fmt ("%.3Le", 1.0005L), "1.001e+00") == 0);
+
+  /* Ties go to even.  */
+  CHECK (strcmp (fmt ("%.0Lf", 0.5L), "0") == 0);
+  CHECK (strcmp (fmt ("%.0Lf", 1.5L), "2") == 0);
+  CHECK (strcmp (fmt ("%.0Lf", 2.5L), "2") == 0);
+  CHECK (strcmp (fmt ("%.2Lf", 1.125L), "1.12") == 0);
+  CHECK (strcmp (fmt ("%.2Lf", 1.375L), "1.38") == 0);
+  CHECK (strcmp (fmt ("%.1Lf", 0.0625L), "0.1") == 0);
+  CHECK (strcmp (fmt ("%.1Lf", 0.04L), "0.0") == 0);
+  CHECK (strcmp (fmt ("%.0Le", 9.5L), "1e+01") == 0);
+
+  /* 21 digits are enough to read any value back.  */
+  for (i = 0; i < 2000; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      x = (long double) seed / 65536;
+      seed = seed * 1103515245 + 12345;
+      x = x * seed + seed % 1000;
+      if (i & 1)
+	x = 1 / x;
+      y = strtold (fmt ("%.20Le", x), NULL);
+      CHECK (x == y);
+    }
+
+  exit (0);
+}
+
+#else
+int main(int argc, char **argv)
+{
+  puts ("No 80-bit long double I/O, SKIP test");
+  exit (0);
+}
+#endif
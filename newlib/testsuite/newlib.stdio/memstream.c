@@ -0,0 +1,80 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* open_memstream keeps *buf and *size current after every flush, seek
+   and close, however the output is buffered.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+int main(int argc, char **argv)
+{
+  char *buf = NULL;
+  size_t size = 1;
+  char mybuf[16];
+  FILE *fp;
+  long i;
+
+  fp = open_memstream (&buf, &size);
+  CHECK (fp != NULL);
+  CHECK (buf != NULL && size == 0 && *buf == '\0');
+
+  /* Many small writes, flushed from time to time.  */
+  for (i = 0; i < 100000; i++)
+    {
+      CHECK (fprintf (fp, "%05ld\n", i % 100000) == 6);
+      if (i % 10007 == 0)
+	{
+	  CHECK (fflush (fp) == 0);
+	  CHECK (size == (size_t) (i + 1) * 6 && buf[size] == '\0');
+	}
+    }
+  CHECK (ftell (fp) == 600000);
+  CHECK (fflush (fp) == 0);
+  CHECK (size == 600000 && buf[size] == '\0');
+  CHECK (memcmp (buf + 6 * 4321, "04321\n", 6) == 0);
+
+  /* Overwrite in the middle; the tail survives and the size is the
+     position until the stream is closed.  */
+  CHECK (fseek (fp, 12, SEEK_SET) == 0);
+  CHECK (fputs ("XY", fp) >= 0);
+  CHECK (ftell (fp) == 14);
+  CHECK (fflush (fp) == 0);
+  CHECK (size == 14 && buf[14] == '\0');
+  CHECK (fseek (fp, 0, SEEK_END) == 0);
+  CHECK (size == 600000);
+  CHECK (memcmp (buf, "00000\n00001\nXY002\n", 18) == 0);
+
+  /* A gap left by seeking past the end reads back as NULs.  */
+  CHECK (fseek (fp, 10, SEEK_END) == 0);
+  CHECK (fputc ('!', fp) == '!');
+  CHECK (fflush (fp) == 0);
+  CHECK (size == 600011 && buf[600000] == '\0' && buf[600009] == '\0');
+  CHECK (buf[600010] == '!' && buf[600011] == '\0');
+
+  /* A buffer of the user's own.  */
+  CHECK (setvbuf (fp, mybuf, _IOFBF, sizeof (mybuf)) == 0);
+  for (i = 0; i < 100; i++)
+    CHECK (fputs ("0123456789", fp) >= 0);
+  CHECK (ftell (fp) == 601011);
+  CHECK (fclose (fp) == 0);
+  CHECK (size == 601011 && buf[size] == '\0');
+  CHECK (memcmp (buf + size - 10, "0123456789", 10) == 0);
+  free (buf);
+
+  /* Unbuffered.  */
+  fp = open_memstream (&buf, &size);
+  CHECK (fp != NULL);
+  CHECK (setvbuf (fp, NULL, _IONBF, 0) == 0);
+  CHECK (fputs ("abc", fp) >= 0);
+  CHECK (size == 3 && strcmp (buf, "abc") == 0);
+  CHECK (fclose (fp) == 0);
+  CHECK (size == 3 && strcmp (buf, "abc") == 0);
+  free (buf);
+
+  exit (0);
+}
@@ -0,0 +1,113 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* A format registered with printf_compile must print exactly what the
+   same format does when it is parsed at each call, however many
+   formats are registered.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <newlib.h>
+#include "check.h"
+
+static const char f_int[] = "x=%d|%5d|%-5d|%05d|%+d|% d|%.3d|%+ d|%%|";
+static const char f_str[] = "%s:%-8.3s:%c:%x:%#o:%#X:%10p.";
+static const char f_long[] = "%ld %hd %lu %-+12ld";
+static const char f_n[] = "abc%ndefgh%n";
+static const char f_lit[] = "no conversions at all";
+#ifdef _WANT_IO_C99_FORMATS
+static const char f_c99[] = "%hhd %zu %jd %td %lld %llx";
+#endif
+#if !defined(INTEGER_ONLY) && !defined(NO_FLOATING_POINT)
+static const char f_float[] = "%8.3f|%e|%-10g|%+.0f";
+#endif
+
+#define NMANY 1000
+static char f_many[NMANY][16];
+
+/* The registry lookup used by the printf family.  */
+extern const void *__pf_lookup (const char *);
+
+static void
+check (const char *fmt, ...)
+{
+  char copy[64], want[128], got[128];
+  va_list ap, aq;
+
+  strcpy (copy, fmt);
+  va_start (ap, fmt);
+  va_copy (aq, ap);
+  CHECK (vsnprintf (want, sizeof (want), copy, aq) ==
+	 vsnprintf (got, sizeof (got), fmt, ap));
+  va_end (aq);
+  va_end (ap);
+  CHECK (strcmp (want, got) == 0);
+}
+
+int main()
+{
+  int n1, n2, m1, m2, i;
+  char buf[32];
+
+  CHECK (printf_compile (f_int) == 0);
+  CHECK (printf_compile (f_str) == 0);
+  CHECK (printf_compile (f_long) == 0);
+  CHECK (printf_compile (f_n) == 0);
+  CHECK (printf_compile (f_lit) == 0);
+  CHECK (printf_compile (f_lit) == 0);
+
+  check (f_int, 1, 2, 3, -4, 5, 6, 7, 8);
+  check (f_str, "hello", "world", 'c', 255u, 8u, 0xabcu, (void *) f_str);
+  check (f_long, -123456789L, (short) -5, 42ul, 99L);
+  check (f_lit);
+
+  CHECK (snprintf (buf, sizeof (buf), f_n, &n1, &n2) == 8);
+  strcpy (buf, f_n);
+  snprintf (buf, sizeof (buf), buf, &m1, &m2);
+  CHECK (n1 == m1 && n2 == m2);
+
+  /* Truncated output.  */
+  CHECK (snprintf (buf, 4, f_int, 1, 2, 3, 4, 5, 6, 7, 8) ==
+	 snprintf (buf, 4, strcpy (buf, f_int), 1, 2, 3, 4, 5, 6, 7, 8));
+
+#ifdef _WANT_IO_C99_FORMATS
+  CHECK (printf_compile (f_c99) == 0);
+  check (f_c99, -3, (size_t) 7, (intmax_t) -8, (ptrdiff_t) 9,
+	 -1234567890123LL, 0xdeadbeefcafeULL);
+  errno = 0;
+  CHECK (printf_compile ("%'d") == -1 && errno == EINVAL);
+#endif
+#if !defined(INTEGER_ONLY) && !defined(NO_FLOATING_POINT)
+  CHECK (printf_compile (f_float) == 0);
+  check (f_float, 3.14159, 1e10, 0.0001, 2.5);
+#endif
+
+  /* Formats that need the full parser are refused.  */
+  errno = 0;
+  CHECK (printf_compile ("%*d") == -1 && errno == EINVAL);
+  CHECK (printf_compile ("%.*d") == -1);
+  CHECK (printf_compile ("%1$d") == -1);
+  CHECK (printf_compile ("trailing %") == -1);
+  CHECK (printf_compile ("%y") == -1);
+
+  /* Many more formats than the registry starts out with.  */
+  for (i = 0; i < NMANY; i++)
+    {
+      sprintf (f_many[i], "%%d-%d|%%x", i);
+      CHECK (printf_compile (f_many[i]) == 0);
+    }
+  CHECK (__pf_lookup (f_int) != NULL);
+  CHECK (__pf_lookup (buf) == NULL);
+  for (i = 0; i < NMANY; i++)
+    {
+      CHECK (__pf_lookup (f_many[i]) != NULL);
+      check (f_many[i], -i, i * 3);
+    }
+
+  exit (0);
+}
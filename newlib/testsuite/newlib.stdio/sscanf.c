@@ -0,0 +1,59 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Decimal fields convert like strtol, and %[ and %s take whole runs.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include "check.h"
+
+int main(int argc, char **argv)
+{
+  int a, b, c, n;
+  long l;
+  unsigned int u;
+  char s1[16], s2[16], s3[16];
+
+  CHECK (sscanf ("12,-34,+56", "%d,%d,%d%n", &a, &b, &c, &n) == 3);
+  CHECK (a == 12 && b == -34 && c == 56 && n == 10);
+
+  /* Leading zeros, widths and what is left for the next field.  */
+  CHECK (sscanf ("0000123 4567", "%d %2d%d", &a, &b, &c) == 3);
+  CHECK (a == 123 && b == 45 && c == 67);
+  CHECK (sscanf ("0007", "%3d%d", &a, &b) == 2 && a == 0 && b == 7);
+
+  /* A sign on its own does not match.  */
+  CHECK (sscanf ("-x", "%d", &a) == 0);
+  CHECK (sscanf ("-", "%d", &a) == 0);
+
+  /* Overflow saturates as strtol does.  */
+  errno = 0;
+  CHECK (sscanf ("99999999999999999999", "%ld", &l) == 1);
+  CHECK (l == LONG_MAX && errno == ERANGE);
+  errno = 0;
+  CHECK (sscanf ("-99999999999999999999", "%ld", &l) == 1);
+  CHECK (l == LONG_MIN && errno == ERANGE);
+  errno = 0;
+  CHECK (sscanf ("*99999999999999999999", "*%*d%n", &n) == 0 && n == 21);
+  CHECK (errno == 0);
+  CHECK (sscanf ("-1", "%u", &u) == 1 && u == UINT_MAX);
+
+  /* Repeated scansets, and fields ending at the end of the input.  */
+  CHECK (sscanf ("ab,cd,ef", "%[^,],%[^,],%[^,]", s1, s2, s3) == 3);
+  CHECK (strcmp (s1, "ab") == 0 && strcmp (s2, "cd") == 0
+	 && strcmp (s3, "ef") == 0);
+  CHECK (sscanf ("abc,d", "%2[^,]%[^,],%s", s1, s2, s3) == 3);
+  CHECK (strcmp (s1, "ab") == 0 && strcmp (s2, "c") == 0
+	 && strcmp (s3, "d") == 0);
+  CHECK (sscanf (",x", "%[^,]", s1) == 0);
+  CHECK (sscanf ("hello world", "%3s%s %s", s1, s2, s3) == 3);
+  CHECK (strcmp (s1, "hel") == 0 && strcmp (s2, "lo") == 0
+	 && strcmp (s3, "world") == 0);
+
+  exit (0);
+}
@@ -0,0 +1,88 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Wide streams convert ASCII runs without going through the charset's
+   conversion functions.  Mixed text must still round-trip, in the C
+   locale and, where available, in a UTF-8 locale.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <newlib.h>
+#include "check.h"
+
+static wchar_t text[3000];
+static wchar_t line[3000];
+static char mem[16000];
+
+/* TEXT holds N characters, the last one a newline.  */
+static void
+roundtrip (int n)
+{
+  FILE *fp;
+  wint_t wc;
+  int i;
+
+  CHECK ((fp = fmemopen (mem, sizeof mem, "w+")) != NULL);
+  CHECK (fputws (text, fp) >= 0);
+  CHECK (fwprintf (fp, L"%.5ls|%lc|%d\n", text + n - 6, text[n - 2], 42) > 0);
+  CHECK (fputwc (L'x', fp) == L'x');
+  rewind (fp);
+
+  i = 0;
+  while (fgetws (line, 40, fp) != NULL)
+    {
+      CHECK (wcsncmp (line, text + i, wcslen (line)) == 0);
+      i += wcslen (line);
+      if (i == n)
+	break;
+    }
+  CHECK (i == n);
+  CHECK (fgetws (line, sizeof line / sizeof line[0], fp) != NULL);
+  CHECK (wcsncmp (line, text + n - 6, 5) == 0);
+  CHECK (line[5] == L'|' && line[6] == text[n - 2]);
+  CHECK (wcscmp (line + 7, L"|42\n") == 0);
+  CHECK ((wc = fgetwc (fp)) == L'x');
+  CHECK (fgetwc (fp) == WEOF);
+  fclose (fp);
+}
+
+int main()
+{
+  FILE *fp;
+  int i, n;
+
+  /* Lines of ASCII.  */
+  for (i = 0; i < 2500; i++)
+    text[i] = i % 61 == 60 ? L'\n' : L' ' + i % 90;
+  text[2499] = L'\n';
+  roundtrip (2500);
+
+  /* Characters up to 0xff are written as single bytes in the C locale.  */
+  CHECK ((fp = fmemopen (mem, sizeof mem, "w")) != NULL);
+  CHECK (fwprintf (fp, L"%lc%lc", (wint_t) 0xe9, (wint_t) L'a') == 2);
+  CHECK (fputws (L"\xff", fp) >= 0);
+  CHECK (fputwc ((wchar_t) 0xe9, fp) == 0xe9);
+  CHECK (fflush (fp) == 0);
+  CHECK (memcmp (mem, "\xe9" "a\xff\xe9", 4) == 0);
+  fclose (fp);
+
+#ifdef _MB_CAPABLE
+  if (setlocale (LC_CTYPE, "C.UTF-8") != NULL)
+    {
+      /* Runs of ASCII and non-ASCII, split across stream buffers.  */
+      for (i = n = 0; n < 2500; i++)
+	text[n++] = i % 7 == 0 ? 0x400 + i % 200
+		  : i % 53 == 0 ? L'\n'
+		  : i % 11 == 0 ? 0x20ac : L'a' + i % 26;
+      text[n - 1] = L'\n';
+      roundtrip (n);
+    }
+#endif
+
+  exit (0);
+}
@@ -0,0 +1,53 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* A fork child must not repeat its parent's arc4random output, even
+   when the parent's generator was seeded before the fork.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#if defined(__linux__)
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define N 16
+
+int main()
+{
+  unsigned int parent[N], child[N];
+  int fd[2], status, i;
+  pid_t pid;
+
+  (void) arc4random ();
+  CHECK (pipe (fd) == 0);
+  CHECK ((pid = fork ()) >= 0);
+  if (pid == 0)
+    {
+      for (i = 0; i < N; i++)
+	child[i] = arc4random ();
+      _exit (write (fd[1], child, sizeof child) == sizeof child ? 0 : 1);
+    }
+  for (i = 0; i < N; i++)
+    parent[i] = arc4random ();
+  memset (child, 0, sizeof child);
+  CHECK (read (fd[0], child, sizeof child) == sizeof child);
+  CHECK (waitpid (pid, &status, 0) == pid);
+  CHECK (WIFEXITED (status) && WEXITSTATUS (status) == 0);
+  CHECK (memcmp (parent, child, sizeof parent) != 0);
+
+  exit (0);
+}
+
+#else
+int main(int argc, char **argv)
+{
+  puts ("No fork in this configuration, SKIP test");
+  exit (0);
+}
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* __cxa_finalize must call the handlers of one DSO, newest first,
+   leave those of other DSOs alone, and call handlers registered by a
+   running handler before the older ones.  Whatever is left runs at
+   exit.  */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+extern int __cxa_atexit (void (*) (void *), void *, void *);
+extern void __cxa_finalize (void *);
+
+#define NDSO 3
+#define NPER 40
+
+static char dso[NDSO];
+static int expect[NDSO];
+static int ran_extra;
+static int at_exit_next = NPER - 1;
+
+static void
+handler (void *arg)
+{
+  int k = (int) (long) arg;
+  int d = k / NPER;
+
+  if (k % NPER != expect[d])
+    abort ();
+  expect[d]--;
+}
+
+static void
+extra (void *arg)
+{
+  /* Must run before the handler that registered it.  */
+  if (expect[1] != 9)
+    abort ();
+  ran_extra = 1;
+}
+
+static void
+register_extra (void *arg)
+{
+  handler (arg);
+  if (__cxa_atexit (extra, NULL, &dso[1]) != 0)
+    abort ();
+}
+
+static void
+at_exit (void *arg)
+{
+  if ((int) (long) arg != 2 * NPER + at_exit_next--)
+    abort ();
+}
+
+/* Registered first, so it runs last: every handler of dso[2] must
+   have run by then.  */
+static void
+check_exit (void)
+{
+  if (at_exit_next != -1)
+    abort ();
+  _exit (0);
+}
+
+int
+main (void)
+{
+  int i, d;
+
+  /* atexit only refers weakly to the allocator; make sure it is linked
+     in, so that blocks past the first can be allocated and indexed.  */
+  free (realloc (NULL, 1));
+
+  if (atexit (check_exit) != 0)
+    abort ();
+
+  for (i = 0; i < NPER; i++)
+    for (d = 0; d < NDSO; d++)
+      if (__cxa_atexit (d == 2 ? at_exit : d == 1 && i == 10
+			? register_extra : handler,
+			(void *) (long) (d * NPER + i), &dso[d]) != 0)
+	abort ();
+
+  for (d = 0; d < 2; d++)
+    expect[d] = NPER - 1;
+
+  __cxa_finalize (&dso[0]);
+  if (expect[0] != -1 || expect[1] != NPER - 1)
+    abort ();
+  __cxa_finalize (&dso[0]);
+
+  __cxa_finalize (&dso[1]);
+  if (expect[1] != -1 || !ran_extra)
+    abort ();
+
+  exit (0);
+}
@@ -0,0 +1,107 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Compare strstr, memmem and strcasestr against naive searches on
+   small-alphabet inputs, which produce many first/last byte candidates
+   and exercise the fallback to Two-Way, and with the haystack placed
+   at every offset relative to a vector boundary.  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define MAX_HAY 300
+#define MAX_NEEDLE 40
+#define TOO_MANY_ERRORS 11
+
+static int errors = 0;
+
+static char hay_buf[MAX_HAY + 64];
+static char needle[MAX_NEEDLE + 1];
+
+static const char *
+naive_strstr (const char *h, const char *n, int fold)
+{
+  size_t nl = strlen (n);
+
+  for (;; h++)
+    {
+      if ((fold ? strncasecmp (h, n, nl) : strncmp (h, n, nl)) == 0)
+	return h;
+      if (*h == '\0')
+	return NULL;
+    }
+}
+
+static const char *
+naive_memmem (const char *h, size_t hl, const char *n, size_t nl)
+{
+  size_t i;
+
+  for (i = 0; i + nl <= hl; i++)
+    if (memcmp (h + i, n, nl) == 0)
+      return h + i;
+  return NULL;
+}
+
+static void
+check (const char *what, const char *got, const char *want, size_t hl,
+       size_t nl, size_t align)
+{
+  if (got == want)
+    return;
+  if (++errors <= TOO_MANY_ERRORS)
+    printf ("%s: haystack %u needle %u align %u: got %p want %p\n", what,
+	    (unsigned) hl, (unsigned) nl, (unsigned) align,
+	    (void *) got, (void *) want);
+}
+
+int
+main (void)
+{
+  unsigned int seed = 1;
+  size_t hl, nl, align, i;
+  int iter;
+  char *h;
+
+  for (iter = 0; iter < 4000; iter++)
+    {
+      seed = seed * 1103515245 + 12345;
+      hl = (seed >> 8) % MAX_HAY;
+      nl = 1 + (seed >> 20) % MAX_NEEDLE;
+      align = iter % 32;
+      h = hay_buf + align;
+      for (i = 0; i < hl; i++)
+	{
+	  seed = seed * 1103515245 + 12345;
+	  h[i] = ((seed >> 16) & 1 ? 'a' : 'A') + (seed >> 17) % 3;
+	}
+      h[hl] = '\0';
+      for (i = 0; i < nl; i++)
+	{
+	  seed = seed * 1103515245 + 12345;
+	  needle[i] = ((seed >> 16) & 1 ? 'a' : 'A') + (seed >> 17) % 3;
+	}
+      needle[nl] = '\0';
+      if (hl >= nl && (iter & 1))
+	memcpy (h + (seed >> 4) % (hl - nl + 1), needle, nl);
+
+      check ("strstr", strstr (h, needle), naive_strstr (h, needle, 0),
+	     hl, nl, align);
+      check ("strcasestr", strcasestr (h, needle),
+	     naive_strstr (h, needle, 1), hl, nl, align);
+      check ("memmem", memmem (h, hl, needle, nl),
+	     naive_memmem (h, hl, needle, nl), hl, nl, align);
+    }
+
+  if (errors != 0)
+    {
+      printf ("ERROR. FAILED.\n");
+      abort ();
+    }
+  exit (0);
+}
@@ -0,0 +1,93 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Arrays of primitive types code to the same bytes whether the stream
+   can inline runs (xdrmem) or not (xdrstdio), and xdr_sizeof agrees.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#if defined(__CYGWIN__)
+
+#include <rpc/types.h>
+#include <rpc/xdr.h>
+
+#define N 3000
+
+static int ints[N], ints2[N];
+static double dbls[N], dbls2[N];
+static char mem[2 * N * 12];
+
+static bool_t
+code (XDR *xdrs, int *ip, double *dp)
+{
+  u_int n = N;
+  caddr_t a = (caddr_t) ip;
+
+  return xdr_array (xdrs, &a, &n, N, sizeof (int), (xdrproc_t) xdr_int)
+	 && xdr_vector (xdrs, (char *) dp, N, sizeof (double),
+			(xdrproc_t) xdr_double);
+}
+
+static bool_t
+code_ints_dbls (XDR *xdrs, void *unused)
+{
+  return code (xdrs, ints, dbls);
+}
+
+int main(int argc, char **argv)
+{
+  XDR xdrs;
+  FILE *fp;
+  u_int len;
+  int i;
+
+  for (i = 0; i < N; i++)
+    {
+      ints[i] = (int) ((u_int) i * 0x01010101u) - 7;
+      dbls[i] = i / 3.0 - 100;
+    }
+
+  xdrmem_create (&xdrs, mem, sizeof (mem), XDR_ENCODE);
+  CHECK (code (&xdrs, ints, dbls));
+  len = xdr_getpos (&xdrs);
+  CHECK (len == 4 + N * 4 + N * 8);
+  CHECK (mem[4] == (char) 0xff && mem[7] == (char) 0xf9);
+  CHECK (xdr_sizeof ((xdrproc_t) code_ints_dbls, NULL) == len);
+
+  fp = tmpfile ();
+  CHECK (fp != NULL);
+  xdrstdio_create (&xdrs, fp, XDR_ENCODE);
+  CHECK (code (&xdrs, ints, dbls));
+  xdr_destroy (&xdrs);
+  CHECK (ftell (fp) == (long) len);
+  rewind (fp);
+  for (i = 0; i < (int) len; i++)
+    CHECK (getc (fp) == (unsigned char) mem[i]);
+
+  rewind (fp);
+  xdrstdio_create (&xdrs, fp, XDR_DECODE);
+  CHECK (code (&xdrs, ints2, dbls2));
+  xdr_destroy (&xdrs);
+  CHECK (memcmp (ints, ints2, sizeof (ints)) == 0);
+  CHECK (memcmp (dbls, dbls2, sizeof (dbls)) == 0);
+  fclose (fp);
+
+  /* A short buffer fails instead of overrunning.  */
+  xdrmem_create (&xdrs, mem, len - 4, XDR_ENCODE);
+  CHECK (!code (&xdrs, ints, dbls));
+
+  exit (0);
+}
+
+#else
+int main(int argc, char **argv)
+{
+  puts ("No XDR in this configuration, SKIP test");
+  exit (0);
+}
+#endif
@@ -0,0 +1,135 @@
+/*
+ * Permission to use, copy, modify, and distribute this software
+ * is freely granted, provided that this notice is preserved.
+ */
+
+/* Record streams: large byte items go out through the gather-write
+   transport and come back in whole, and bytes are borrowed from the
+   receive buffer only when they lie within one fragment.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+
+#if defined(__CYGWIN__)
+
+#include <rpc/types.h>
+#include <rpc/xdr.h>
+
+#define BUFSZ 128		/* 124 data bytes per fragment */
+
+static char wire[20000];
+static int wlen, rpos, nwritev;
+static char big[1000], mid[300], small[100], out[1000];
+
+static int
+writeit (void *h, void *buf, int len)
+{
+  memcpy (wire + wlen, buf, len);
+  wlen += len;
+  return len;
+}
+
+static int
+writevit (void *h, const struct xdr_iovec *iov, int cnt)
+{
+  int i, n = 0;
+
+  nwritev++;
+  for (i = 0; i < cnt; i++)
+    n += writeit (h, iov[i].iov_base, iov[i].iov_len);
+  return n;
+}
+
+/* Hand out at most 37 bytes at a time, so that reads end mid-item.  */
+static int
+readit (void *h, void *buf, int len)
+{
+  if (len > 37)
+    len = 37;
+  if (len > wlen - rpos)
+    len = wlen - rpos;
+  if (len <= 0)
+    return -1;
+  memcpy (buf, wire + rpos, len);
+  rpos += len;
+  return len;
+}
+
+int main(int argc, char **argv)
+{
+  XDR xdrs;
+  caddr_t p;
+  int i, n;
+
+  for (i = 0; i < sizeof big; i++)
+    big[i] = (char) (i * 7 + 1);
+  for (i = 0; i < sizeof mid; i++)
+    mid[i] = (char) (i * 5 + 2);
+  for (i = 0; i < sizeof small; i++)
+    small[i] = (char) (i * 3 + 3);
+
+  /* Record 1: a buffered item, then a large one that is sent with
+     the buffered bytes in a single writev.  */
+  xdrrec_create (&xdrs, BUFSZ, BUFSZ, NULL, readit, writeit);
+  xdrrec_setwritev (&xdrs, writevit, 200);
+  xdrs.x_op = XDR_ENCODE;
+  n = 42;
+  CHECK (xdr_int (&xdrs, &n));
+  CHECK (xdr_opaque (&xdrs, small, sizeof small));
+  CHECK (xdr_opaque (&xdrs, big, sizeof big));
+  CHECK (xdr_opaque (&xdrs, mid, sizeof mid));
+  CHECK (xdr_opaque (&xdrs, small, 20));
+  CHECK (xdrrec_endofrecord (&xdrs, TRUE));
+  CHECK (nwritev == 2);
+
+  /* Record 2, copied into 124-byte fragments: 100 bytes, 40 bytes
+     across the first fragment end, then 80 bytes within the second.  */
+  xdrrec_setwritev (&xdrs, NULL, 0);
+  CHECK (xdr_opaque (&xdrs, small, 100));
+  CHECK (xdr_opaque (&xdrs, mid, 40));
+  CHECK (xdr_opaque (&xdrs, big, 80));
+  CHECK (xdrrec_endofrecord (&xdrs, TRUE));
+  CHECK (nwritev == 2);
+  xdr_destroy (&xdrs);
+
+  xdrrec_create (&xdrs, BUFSZ, BUFSZ, NULL, readit, writeit);
+  xdrs.x_op = XDR_DECODE;
+  CHECK (xdrrec_skiprecord (&xdrs));
+  CHECK (xdr_int (&xdrs, &n) && n == 42);
+  CHECK (xdr_opaque (&xdrs, out, sizeof small));
+  CHECK (memcmp (out, small, sizeof small) == 0);
+  /* Larger than the receive buffer: read straight into OUT.  */
+  CHECK (xdrrec_borrowbytes (&xdrs, sizeof big) == NULL);
+  CHECK (xdr_opaque (&xdrs, out, sizeof big));
+  CHECK (memcmp (out, big, sizeof big) == 0);
+  CHECK (xdr_opaque (&xdrs, out, sizeof mid));
+  CHECK (memcmp (out, mid, sizeof mid) == 0);
+  CHECK ((p = xdrrec_borrowbytes (&xdrs, 20)) != NULL);
+  CHECK (memcmp (p, small, 20) == 0);
+
+  CHECK (xdrrec_skiprecord (&xdrs));
+  CHECK (xdr_opaque (&xdrs, out, 100));
+  CHECK (memcmp (out, small, 100) == 0);
+  /* Crosses the fragment end: nothing is consumed, so copy it.  */
+  CHECK (xdrrec_borrowbytes (&xdrs, 40) == NULL);
+  CHECK (xdr_opaque (&xdrs, out, 40));
+  CHECK (memcmp (out, mid, 40) == 0);
+  /* Only partly buffered: compacted, then lent in place.  */
+  CHECK ((p = xdrrec_borrowbytes (&xdrs, 80)) != NULL);
+  CHECK (memcmp (p, big, 80) == 0);
+  CHECK (xdrrec_borrowbytes (&xdrs, 4) == NULL);
+  CHECK (rpos == wlen);
+  xdr_destroy (&xdrs);
+
+  exit (0);
+}
+
+#else
+int main(int argc, char **argv)
+{
+  puts ("No XDR in this configuration, SKIP test");
+  exit (0);
+}
+#endif
@@ -1091,7 +1091,8 @@ __collate_load_locale (struct __locale_t *locale, const char *name,
       bufp = (char *) malloc (1);	/* dummy */
       if (!bufp)
 	return -1;
-      cop = (struct lc_collate_T *) calloc (1, sizeof (struct lc_collate_T));
+      cop = (struct lc_collate_T *)
+	    __lc_cat_alloc (sizeof (struct lc_collate_T));
       if (!cop)
 	{
 	  free (bufp);
@@ -1104,12 +1105,8 @@ __collate_load_locale (struct __locale_t *locale, const char *name,
   struct __lc_cats tmp = locale->lc_cat[LC_COLLATE];
   locale->lc_cat[LC_COLLATE].ptr = lcid == 0 ? &_C_collate_locale : cop;
   locale->lc_cat[LC_COLLATE].buf = bufp;
-  /* If buf is not NULL, both pointers have been alloc'ed */
-  if (tmp.buf)
-    {
-      free ((void *) tmp.ptr);
-      free (tmp.buf);
-    }
+  /* Other locale objects may still share the old data. */
+  __lc_cat_unref (&tmp);
   return 0;
 }
 